@@ -21,6 +21,20 @@ LOCAL_SRC_FILES := \
 	$(LOCAL_PATH)/../common/EffekseerPluginSound.cpp \
 	$(LOCAL_PATH)/../common/EffekseerPlugin.cpp \
 	$(LOCAL_PATH)/../common/MemoryFile.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginCommand.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginGroup.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginScheduler.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginBudget.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginSeek.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginInstancing.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginBake.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginManagers.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginAsync.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginMappedFile.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginBundle.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginCompression.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginHash.cpp \
+	$(LOCAL_PATH)/../common/EffekseerPluginEffectCache.cpp \
 	$(LOCAL_PATH)/../renderer/EffekseerRendererImplemented.cpp \
 	$(LOCAL_PATH)/../renderer/EffekseerRendererIndexBuffer.cpp \
 	$(LOCAL_PATH)/../renderer/EffekseerRendererModelLoader.cpp \
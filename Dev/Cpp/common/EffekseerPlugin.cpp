@@ -60,6 +60,17 @@
 #include "EffekseerRendererXBoxOneDx12.h"
 #endif
 
+#include "../common/EffekseerPluginAsync.h"
+#include "../common/EffekseerPluginGroup.h"
+#include "../common/EffekseerPluginScheduler.h"
+#include "../common/EffekseerPluginBudget.h"
+#include "../common/EffekseerPluginSeek.h"
+#include "../common/EffekseerPluginInstancing.h"
+#include "../common/EffekseerPluginBake.h"
+#include "../common/EffekseerPluginManagers.h"
+#include "../common/EffekseerPluginMappedFile.h"
+#include "../common/EffekseerPluginBundle.h"
+#include "../common/EffekseerPluginEffectCache.h"
 #include "../common/EffekseerPluginMaterial.h"
 #include "../common/EffekseerPluginModel.h"
 #include "../common/EffekseerPluginTexture.h"
@@ -180,6 +191,12 @@ void InitRenderer()
 	g_EffekseerRenderer->SetLightColor(Effekseer::Color(255, 255, 255, 255));
 	g_EffekseerRenderer->SetLightDirection(Effekseer::Vector3D(1, 1, -1));
 	g_EffekseerRenderer->SetLightAmbientColor(Effekseer::Color(40, 40, 40, 255));
+
+	auto managers = EffectManagers::GetInstance();
+	if (managers != nullptr)
+	{
+		managers->SetRenderer(g_EffekseerRenderer);
+	}
 }
 
 void TermRenderer()
@@ -479,6 +496,9 @@ extern "C"
 		g_EffekseerRenderer->SetTime(g_time);
 		g_EffekseerRenderer->BeginRendering();
 		g_EffekseerManager->Draw(drawParameter);
+		InstancedEffects::Draw(g_EffekseerManager, g_graphics, g_EffekseerRenderer, drawParameter, InstancedDrawPass::All);
+		EffectManagers::Draw(drawParameter, InstancedDrawPass::All);
+		BakedClips::Draw(g_EffekseerRenderer, InstancedDrawPass::All);
 		g_EffekseerRenderer->EndRendering();
 
 		if (renderPath != nullptr)
@@ -536,6 +556,9 @@ extern "C"
 		g_EffekseerRenderer->SetTime(g_time);
 		g_EffekseerRenderer->BeginRendering();
 		g_EffekseerManager->DrawFront(drawParameter);
+		InstancedEffects::Draw(g_EffekseerManager, g_graphics, g_EffekseerRenderer, drawParameter, InstancedDrawPass::Front);
+		EffectManagers::Draw(drawParameter, InstancedDrawPass::Front);
+		BakedClips::Draw(g_EffekseerRenderer, InstancedDrawPass::Front);
 		g_EffekseerRenderer->EndRendering();
 
 		if (renderPass != nullptr)
@@ -705,6 +728,9 @@ extern "C"
 		g_EffekseerRenderer->SetLightDirection(g_lightDirection);
 		g_EffekseerRenderer->BeginRendering();
 		g_EffekseerManager->DrawBack(drawParameter);
+		InstancedEffects::Draw(g_EffekseerManager, g_graphics, g_EffekseerRenderer, drawParameter, InstancedDrawPass::Back);
+		EffectManagers::Draw(drawParameter, InstancedDrawPass::Back);
+		BakedClips::Draw(g_EffekseerRenderer, InstancedDrawPass::Back);
 		g_EffekseerRenderer->EndRendering();
 
 		if (renderPath != nullptr)
@@ -746,6 +772,18 @@ extern "C"
 
 		g_time = 0.0f;
 
+		EffectGroups::Initialize();
+		UpdateScheduler::Initialize();
+		InstanceBudget::Initialize();
+		SeekableHandles::Initialize();
+		InstancedEffects::Initialize();
+		BakedClips::Initialize();
+		EffectManagers::Initialize();
+		MappedFiles::Initialize();
+		EffectBundles::Initialize();
+		EffectCache::Initialize();
+		AsyncEffectLoader::Initialize(g_EffekseerManager);
+
 		assert(g_graphics == nullptr);
 		if (g_rendererType == RendererType::Native)
 		{
@@ -772,12 +810,27 @@ extern "C"
 
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerTerm()
 	{
+		// effects in loading refer the manager
+		AsyncEffectLoader::Terminate();
+
 		if (g_EffekseerManager != NULL)
 		{
+			MaterialEvent::RemoveManager(g_EffekseerManager);
 			g_EffekseerManager->Destroy();
 			g_EffekseerManager = NULL;
 		}
 
+		EffectGroups::Terminate();
+		UpdateScheduler::Terminate();
+		InstanceBudget::Terminate();
+		SeekableHandles::Terminate();
+		InstancedEffects::Terminate();
+		BakedClips::Terminate();
+		EffectManagers::Terminate();
+		EffectCache::Terminate();
+		EffectBundles::Terminate();
+		MappedFiles::Terminate();
+
 		if (IsRequiredToInitOnRenderThread())
 		{
 			// term on render thread
@@ -816,6 +869,12 @@ extern "C"
 		g_removingRenderPathMutex.lock();
 		g_removingRenderPathes.push_back(renderID);
 		g_removingRenderPathMutex.unlock();
+
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler != nullptr)
+		{
+			scheduler->RemoveCamera(renderID);
+		}
 	}
 
 	Effekseer::TextureLoader* TextureLoader::Create(TextureLoaderLoad load, TextureLoaderUnload unload)
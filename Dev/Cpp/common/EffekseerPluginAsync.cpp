@@ -0,0 +1,518 @@
+#include "EffekseerPluginAsync.h"
+#include "EffekseerPluginNetwork.h"
+#include "MemoryFile.h"
+#include <algorithm>
+#include <chrono>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+std::shared_ptr<AsyncEffectLoader> AsyncEffectLoader::instance_;
+
+AsyncEffectLoader::AsyncEffectLoader(Effekseer::Manager* manager, int32_t workerCount)
+	: manager_(manager), workerCount_(std::max(workerCount, 1))
+{
+}
+
+AsyncEffectLoader::~AsyncEffectLoader() { Stop(); }
+
+void AsyncEffectLoader::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		if (isTerminating_)
+		{
+			return;
+		}
+		isTerminating_ = true;
+		jobs_.clear();
+	}
+	jobCondition_.notify_all();
+
+	// workers may wait for calls of loaders on this thread
+	while (true)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			if (loadingTickets_.empty())
+			{
+				break;
+			}
+		}
+		Pump(1.0f);
+	}
+
+	// workers do not call loaders anymore
+	std::vector<std::thread> workers;
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		workers.swap(workers_);
+	}
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	// effects which are found in the cache are released from it too
+	auto cache = EffectCache::GetInstance();
+	for (auto& pair : results_)
+	{
+		if (pair.second.IsShared && cache != nullptr)
+		{
+			cache->Release(pair.second.Effect);
+		}
+		ES_SAFE_RELEASE(pair.second.Effect);
+	}
+	results_.clear();
+}
+
+void AsyncEffectLoader::Initialize(Effekseer::Manager* manager, int32_t workerCount)
+{
+	if (workerCount <= 0)
+	{
+		// leave cores for the main thread and the render thread
+		auto cores = static_cast<int32_t>(std::thread::hardware_concurrency());
+		workerCount = std::min(std::max(cores / 2, 1), 4);
+	}
+
+	instance_ = std::make_shared<AsyncEffectLoader>(manager, workerCount);
+}
+
+void AsyncEffectLoader::Terminate()
+{
+	// calls of loaders are dispatched while the instance is found
+	if (instance_ != nullptr)
+	{
+		instance_->Stop();
+	}
+	instance_ = nullptr;
+}
+
+std::shared_ptr<AsyncEffectLoader> AsyncEffectLoader::GetInstance() { return instance_; }
+
+void AsyncEffectLoader::StartWorkersWithoutLock()
+{
+#if !defined(EMSCRIPTEN) && !defined(_SWITCH)
+	if (!workers_.empty())
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < workerCount_; i++)
+	{
+		workers_.emplace_back([this]() { Work(); });
+	}
+#endif
+}
+
+Effekseer::Effect* AsyncEffectLoader::Execute(const Job& job)
+{
+	if (job.Data.empty())
+	{
+		return Effekseer::Effect::Create(manager_, (const EFK_CHAR*)job.Path.c_str(), job.Magnification);
+	}
+
+	// compressed data is decompressed on a worker too
+	Effekseer::Effect* effect = nullptr;
+	const uint8_t* data = job.Data.data();
+	size_t size = job.Data.size();
+	MemoryBufferPool::Buffer decompressed;
+	if (DecompressIfCompressed(data, size, decompressed))
+	{
+		effect = Effekseer::Effect::Create(manager_, const_cast<uint8_t*>(data), static_cast<int32_t>(size), job.Magnification);
+	}
+
+	if (effect != nullptr)
+	{
+		effect->SetName((const EFK_CHAR*)job.Path.c_str());
+	}
+	return effect;
+}
+
+void AsyncEffectLoader::Work()
+{
+	while (true)
+	{
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> lock(mtx_);
+			jobCondition_.wait(lock, [this]() { return isTerminating_ || !jobs_.empty(); });
+			if (isTerminating_)
+			{
+				return;
+			}
+
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+			loadingTickets_[std::this_thread::get_id()] = job.Ticket;
+		}
+
+		auto effect = Execute(job);
+
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			auto& result = results_[job.Ticket];
+			result.State = effect != nullptr ? AsyncLoadState::Loaded : AsyncLoadState::Failed;
+			result.Effect = effect;
+			loadingTickets_.erase(std::this_thread::get_id());
+		}
+
+		// stop waiting in Pump
+		taskCondition_.notify_all();
+	}
+}
+
+void AsyncEffectLoader::Dispatch(const std::function<void()>& function)
+{
+	std::unique_lock<std::mutex> lock(mtx_);
+
+	Task task;
+	task.Ticket = loadingTickets_[std::this_thread::get_id()];
+	task.Function = function;
+	tasks_.push_back(&task);
+
+	taskCondition_.notify_all();
+	taskCondition_.wait(lock, [&task]() { return task.IsDone; });
+}
+
+bool AsyncEffectLoader::IsWorkerThread()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	const auto id = std::this_thread::get_id();
+	return std::any_of(workers_.begin(), workers_.end(), [&id](const std::thread& worker) { return worker.get_id() == id; });
+}
+
+void AsyncEffectLoader::Invoke(const std::function<void()>& function)
+{
+	auto loader = GetInstance();
+	if (loader != nullptr && loader->IsWorkerThread())
+	{
+		loader->Dispatch(function);
+	}
+	else
+	{
+		function();
+	}
+}
+
+int32_t AsyncEffectLoader::Load(const void* data, int32_t size, const char16_t* path, float magnification)
+{
+	Job job;
+	if (data != nullptr && size > 0)
+	{
+		auto p = static_cast<const uint8_t*>(data);
+		job.Data.assign(p, p + size);
+	}
+	else if (path == nullptr)
+	{
+		return -1;
+	}
+
+	if (path != nullptr)
+	{
+		job.Path = path;
+	}
+	job.Magnification = magnification;
+
+	// the same data which is already loaded is shared without a job
+	Result result;
+	auto cache = EffectCache::GetInstance();
+	if (!job.Data.empty() && cache != nullptr)
+	{
+		result.IsCacheable = true;
+		result.CacheKey = EffectCache::CreateKey(job.Data.data(), static_cast<int32_t>(job.Data.size()), magnification);
+		result.Effect = cache->Find(result.CacheKey);
+		if (result.Effect != nullptr)
+		{
+			result.State = AsyncLoadState::Loaded;
+			result.IsCacheable = false;
+			result.IsShared = true;
+		}
+	}
+
+	int32_t ticket = -1;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		if (!isTerminating_)
+		{
+			ticket = nextTicket_++;
+			results_[ticket] = result;
+
+			if (result.Effect == nullptr)
+			{
+				job.Ticket = ticket;
+				jobs_.push_back(std::move(job));
+				StartWorkersWithoutLock();
+			}
+		}
+	}
+
+	if (ticket < 0)
+	{
+		if (result.Effect != nullptr)
+		{
+			cache->Release(result.Effect);
+			result.Effect->Release();
+		}
+		return -1;
+	}
+
+	if (result.Effect != nullptr)
+	{
+		return ticket;
+	}
+
+	jobCondition_.notify_one();
+	return ticket;
+}
+
+int32_t AsyncEffectLoader::Pump(float maxMilliseconds)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto deadline = Clock::now() + std::chrono::microseconds(static_cast<int64_t>(maxMilliseconds * 1000.0f));
+
+	int32_t count = 0;
+	std::unique_lock<std::mutex> lock(mtx_);
+
+	while (true)
+	{
+		while (!tasks_.empty())
+		{
+			auto task = tasks_.front();
+			tasks_.pop_front();
+			pumpingTicket_ = task->Ticket;
+
+			lock.unlock();
+			task->Function();
+			lock.lock();
+
+			pumpingTicket_ = -1;
+			task->IsDone = true;
+			taskCondition_.notify_all();
+			count++;
+		}
+
+		// without workers, effects are loaded here and loaders are called directly
+		while (workers_.empty() && !jobs_.empty() && Clock::now() < deadline)
+		{
+			auto job = std::move(jobs_.front());
+			jobs_.pop_front();
+			pumpingTicket_ = job.Ticket;
+
+			lock.unlock();
+			auto effect = Execute(job);
+			lock.lock();
+
+			pumpingTicket_ = -1;
+			auto& result = results_[job.Ticket];
+			result.State = effect != nullptr ? AsyncLoadState::Loaded : AsyncLoadState::Failed;
+			result.Effect = effect;
+			count++;
+		}
+
+		auto isIdle = [this]() { return loadingTickets_.empty() && (jobs_.empty() || workers_.empty()); };
+		if (isIdle() || Clock::now() >= deadline)
+		{
+			break;
+		}
+
+		taskCondition_.wait_until(lock, deadline, [this, &isIdle]() { return !tasks_.empty() || isIdle(); });
+	}
+
+	return count;
+}
+
+AsyncLoadState AsyncEffectLoader::GetState(int32_t ticket)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = results_.find(ticket);
+	if (it == results_.end())
+	{
+		return AsyncLoadState::Invalid;
+	}
+	return it->second.State;
+}
+
+Effekseer::Effect* AsyncEffectLoader::Take(int32_t ticket)
+{
+	Result result;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+
+		auto it = results_.find(ticket);
+		if (it == results_.end() || it->second.State == AsyncLoadState::Loading)
+		{
+			return nullptr;
+		}
+
+		result = it->second;
+		results_.erase(it);
+	}
+
+	auto effect = result.Effect;
+	auto cache = EffectCache::GetInstance();
+	if (effect != nullptr && result.IsCacheable && cache != nullptr)
+	{
+		// another load may have registered the same effect while this effect was created
+		auto sharedEffect = cache->Add(result.CacheKey, effect);
+		if (sharedEffect != effect)
+		{
+			return sharedEffect;
+		}
+	}
+
+#ifndef _SWITCH
+	// an effect which is found in the cache is registered already
+	if (effect != nullptr && !result.IsShared && Network::GetInstance()->IsRunning())
+	{
+		Network::GetInstance()->Register(effect->GetName(), effect);
+	}
+#endif
+
+	return effect;
+}
+
+int32_t AsyncEffectLoader::GetPumpingTicket()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return pumpingTicket_;
+}
+
+Effekseer::TextureData* AsyncTextureLoader::Load(const EFK_CHAR* path, Effekseer::TextureType textureType)
+{
+	Effekseer::TextureData* ret = nullptr;
+	AsyncEffectLoader::Invoke([&]() { ret = loader_->Load(path, textureType); });
+	return ret;
+}
+
+void AsyncTextureLoader::Unload(Effekseer::TextureData* data)
+{
+	AsyncEffectLoader::Invoke([&]() { loader_->Unload(data); });
+}
+
+void* AsyncModelLoader::Load(const EFK_CHAR* path)
+{
+	void* ret = nullptr;
+	AsyncEffectLoader::Invoke([&]() { ret = loader_->Load(path); });
+	return ret;
+}
+
+void AsyncModelLoader::Unload(void* data)
+{
+	AsyncEffectLoader::Invoke([&]() { loader_->Unload(data); });
+}
+
+Effekseer::MaterialData* AsyncMaterialLoader::Load(const EFK_CHAR* path)
+{
+	Effekseer::MaterialData* ret = nullptr;
+	AsyncEffectLoader::Invoke([&]() { ret = loader_->Load(path); });
+	return ret;
+}
+
+void AsyncMaterialLoader::Unload(Effekseer::MaterialData* data)
+{
+	AsyncEffectLoader::Invoke([&]() { loader_->Unload(data); });
+}
+
+void* AsyncSoundLoader::Load(const EFK_CHAR* path)
+{
+	void* ret = nullptr;
+	AsyncEffectLoader::Invoke([&]() { ret = loader_->Load(path); });
+	return ret;
+}
+
+void AsyncSoundLoader::Unload(void* data)
+{
+	AsyncEffectLoader::Invoke([&]() { loader_->Unload(data); });
+}
+
+Effekseer::TextureLoader* CreateAsyncLoader(Effekseer::TextureLoader* loader)
+{
+	return loader != nullptr ? new AsyncTextureLoader(loader) : nullptr;
+}
+
+Effekseer::ModelLoader* CreateAsyncLoader(Effekseer::ModelLoader* loader)
+{
+	return loader != nullptr ? new AsyncModelLoader(loader) : nullptr;
+}
+
+Effekseer::MaterialLoader* CreateAsyncLoader(Effekseer::MaterialLoader* loader)
+{
+	return loader != nullptr ? new AsyncMaterialLoader(loader) : nullptr;
+}
+
+Effekseer::SoundLoader* CreateAsyncLoader(Effekseer::SoundLoader* loader)
+{
+	return loader != nullptr ? new AsyncSoundLoader(loader) : nullptr;
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerLoadEffectAsync(void* data,
+																			int32_t size,
+																			const EFK_CHAR* path,
+																			float magnification)
+	{
+		auto loader = AsyncEffectLoader::GetInstance();
+		if (g_EffekseerManager == nullptr || loader == nullptr)
+		{
+			return -1;
+		}
+
+		return loader->Load(data, size, (const char16_t*)path, magnification);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerPumpEffectLoads(float maxMilliseconds)
+	{
+		auto loader = AsyncEffectLoader::GetInstance();
+		if (loader == nullptr)
+		{
+			return 0;
+		}
+
+		return loader->Pump(maxMilliseconds);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetLoadEffectState(int ticket)
+	{
+		auto loader = AsyncEffectLoader::GetInstance();
+		if (loader == nullptr)
+		{
+			return static_cast<int>(AsyncLoadState::Invalid);
+		}
+
+		return static_cast<int>(loader->GetState(ticket));
+	}
+
+	UNITY_INTERFACE_EXPORT Effekseer::Effect* UNITY_INTERFACE_API EffekseerTakeLoadedEffect(int ticket)
+	{
+		auto loader = AsyncEffectLoader::GetInstance();
+		if (loader == nullptr)
+		{
+			return nullptr;
+		}
+
+		return loader->Take(ticket);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetPumpingLoadTicket()
+	{
+		auto loader = AsyncEffectLoader::GetInstance();
+		if (loader == nullptr)
+		{
+			return -1;
+		}
+
+		return loader->GetPumpingTicket();
+	}
+}
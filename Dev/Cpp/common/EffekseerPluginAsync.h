@@ -0,0 +1,206 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+#include "EffekseerPluginEffectCache.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+
+enum class AsyncLoadState : int32_t
+{
+	Invalid = -1,
+	Loading = 0,
+	Loaded = 1,
+	Failed = 2,
+};
+
+/**
+	@brief	a loader which parses effects on worker threads
+	@note
+	Loaders of resources call back into Unity, so calls from worker threads are queued
+	and executed on the main thread by Pump. A worker waits until its call is executed.
+	Effects are parsed in parallel while loaders are called one by one.
+	Effects which are loaded from memory are shared through EffectCache like synchronous loads.
+	Workers are started by the first load, so an application which never loads asynchronously has no threads.
+	Platforms without threads load effects on the main thread in Pump instead.
+*/
+class AsyncEffectLoader
+{
+private:
+	struct Job
+	{
+		int32_t Ticket = -1;
+		std::vector<uint8_t> Data;
+		std::u16string Path;
+		float Magnification = 1.0f;
+	};
+
+	struct Result
+	{
+		AsyncLoadState State = AsyncLoadState::Loading;
+		Effekseer::Effect* Effect = nullptr;
+		//! whether an effect is added to the cache when it is taken
+		bool IsCacheable = false;
+		//! whether an effect is found in the cache
+		bool IsShared = false;
+		EffectCache::Key CacheKey;
+	};
+
+	struct Task
+	{
+		int32_t Ticket = -1;
+		std::function<void()> Function;
+		bool IsDone = false;
+	};
+
+	Effekseer::Manager* manager_ = nullptr;
+	int32_t workerCount_ = 0;
+
+	std::mutex mtx_;
+	std::condition_variable jobCondition_;
+	std::condition_variable taskCondition_;
+	std::deque<Job> jobs_;
+	std::deque<Task*> tasks_;
+	std::unordered_map<int32_t, Result> results_;
+	std::unordered_map<std::thread::id, int32_t> loadingTickets_;
+	int32_t nextTicket_ = 0;
+	int32_t pumpingTicket_ = -1;
+	bool isTerminating_ = false;
+	std::vector<std::thread> workers_;
+
+	static std::shared_ptr<AsyncEffectLoader> instance_;
+
+	//! start workers if they are not started and the platform supports threads
+	void StartWorkersWithoutLock();
+
+	Effekseer::Effect* Execute(const Job& job);
+
+	void Work();
+
+	void Dispatch(const std::function<void()>& function);
+
+	//! stop workers after calls of loaders which are dispatched by them are executed
+	void Stop();
+
+	bool IsWorkerThread();
+
+public:
+	AsyncEffectLoader(Effekseer::Manager* manager, int32_t workerCount);
+
+	~AsyncEffectLoader();
+
+	//! call it before the manager is destroyed. workers are chosen with the number of cores if workerCount is not positive
+	static void Initialize(Effekseer::Manager* manager, int32_t workerCount = 0);
+
+	static void Terminate();
+
+	static std::shared_ptr<AsyncEffectLoader> GetInstance();
+
+	//! execute a function on the main thread if it is called from a worker thread
+	static void Invoke(const std::function<void()>& function);
+
+	//! load from a path if data is null. return a ticket
+	int32_t Load(const void* data, int32_t size, const char16_t* path, float magnification);
+
+	/**
+		@brief	execute calls of loaders from worker threads, or load effects if there are no workers
+		@param	maxMilliseconds	time to wait for next calls while effects are loaded
+		@return	the number of executed calls and loads
+	*/
+	int32_t Pump(float maxMilliseconds);
+
+	AsyncLoadState GetState(int32_t ticket);
+
+	//! take a loaded effect and forget a ticket. an effect which is loaded from memory is registered to the cache
+	Effekseer::Effect* Take(int32_t ticket);
+
+	//! a ticket whose calls are executed now or -1
+	int32_t GetPumpingTicket();
+};
+
+/**
+	@brief	loaders which execute calls from the worker thread on the main thread
+*/
+class AsyncTextureLoader : public Effekseer::TextureLoader
+{
+	std::unique_ptr<Effekseer::TextureLoader> loader_;
+
+public:
+	AsyncTextureLoader(Effekseer::TextureLoader* loader) : loader_(loader) {}
+
+	virtual ~AsyncTextureLoader() = default;
+
+	Effekseer::TextureData* Load(const EFK_CHAR* path, Effekseer::TextureType textureType) override;
+
+	void Unload(Effekseer::TextureData* data) override;
+};
+
+class AsyncModelLoader : public Effekseer::ModelLoader
+{
+	std::unique_ptr<Effekseer::ModelLoader> loader_;
+
+public:
+	AsyncModelLoader(Effekseer::ModelLoader* loader) : loader_(loader) {}
+
+	virtual ~AsyncModelLoader() = default;
+
+	void* Load(const EFK_CHAR* path) override;
+
+	void Unload(void* data) override;
+};
+
+class AsyncMaterialLoader : public Effekseer::MaterialLoader
+{
+	std::unique_ptr<Effekseer::MaterialLoader> loader_;
+
+public:
+	AsyncMaterialLoader(Effekseer::MaterialLoader* loader) : loader_(loader) {}
+
+	virtual ~AsyncMaterialLoader() = default;
+
+	Effekseer::MaterialData* Load(const EFK_CHAR* path) override;
+
+	void Unload(Effekseer::MaterialData* data) override;
+};
+
+class AsyncSoundLoader : public Effekseer::SoundLoader
+{
+	std::unique_ptr<Effekseer::SoundLoader> loader_;
+
+public:
+	AsyncSoundLoader(Effekseer::SoundLoader* loader) : loader_(loader) {}
+
+	virtual ~AsyncSoundLoader() = default;
+
+	void* Load(const EFK_CHAR* path) override;
+
+	void Unload(void* data) override;
+};
+
+//! wrap a loader to load effects asynchronously. return null if a loader is null
+Effekseer::TextureLoader* CreateAsyncLoader(Effekseer::TextureLoader* loader);
+
+Effekseer::ModelLoader* CreateAsyncLoader(Effekseer::ModelLoader* loader);
+
+Effekseer::MaterialLoader* CreateAsyncLoader(Effekseer::MaterialLoader* loader);
+
+Effekseer::SoundLoader* CreateAsyncLoader(Effekseer::SoundLoader* loader);
+
+} // namespace EffekseerPlugin
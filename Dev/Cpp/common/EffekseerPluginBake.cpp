@@ -0,0 +1,799 @@
+#include "EffekseerPluginBake.h"
+#include "../renderer/EffekseerRendererImplemented.h"
+#include "../renderer/EffekseerRendererShader.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string.h>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+extern EffekseerRenderer::Renderer* g_EffekseerRenderer;
+extern RendererType g_rendererType;
+
+namespace
+{
+enum class ResourceType : int32_t
+{
+	None,
+	ColorImage,
+	NormalImage,
+	DistortionImage,
+	Model,
+	Material,
+	Background,
+};
+
+struct ResourceRef
+{
+	ResourceType Type;
+	int32_t Index;
+};
+
+//! a render parameter whose pointers are replaced with references to resources
+struct BakedParameter
+{
+	UnityRenderParameter Parameter;
+	std::array<ResourceRef, Effekseer::TextureSlotMax> Textures;
+	ResourceRef Model;
+	ResourceRef Material;
+};
+
+struct BakedSegment
+{
+	std::vector<BakedParameter> Parameters;
+	std::vector<uint8_t> VertexBuffer;
+	std::vector<uint8_t> InfoBuffer;
+};
+
+//! segments drawn with DrawBack and DrawFront
+using BakedFrame = std::array<BakedSegment, 2>;
+
+const char ClipMagic[4] = {'E', 'F', 'K', 'B'};
+const int32_t ClipVersion = 1;
+
+Effekseer::Matrix44 ToMatrix44(const float* values)
+{
+	Effekseer::Matrix44 ret;
+	for (int32_t r = 0; r < 4; r++)
+	{
+		for (int32_t c = 0; c < 3; c++)
+		{
+			ret.Values[r][c] = values[r * 3 + c];
+		}
+		ret.Values[r][3] = r == 3 ? 1.0f : 0.0f;
+	}
+	return ret;
+}
+
+int32_t GetResourceCount(Effekseer::Effect* effect, ResourceType type)
+{
+	switch (type)
+	{
+	case ResourceType::ColorImage:
+		return effect->GetColorImageCount();
+	case ResourceType::NormalImage:
+		return effect->GetNormalImageCount();
+	case ResourceType::DistortionImage:
+		return effect->GetDistortionImageCount();
+	case ResourceType::Model:
+		return effect->GetModelCount();
+	case ResourceType::Material:
+		return effect->GetMaterialCount();
+	case ResourceType::Background:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+void* GetResource(Effekseer::Effect* effect, const ResourceRef& ref, void* background)
+{
+	if (ref.Index < 0 || ref.Index >= GetResourceCount(effect, ref.Type))
+	{
+		return nullptr;
+	}
+
+	Effekseer::TextureData* texture = nullptr;
+
+	switch (ref.Type)
+	{
+	case ResourceType::ColorImage:
+		texture = effect->GetColorImage(ref.Index);
+		break;
+	case ResourceType::NormalImage:
+		texture = effect->GetNormalImage(ref.Index);
+		break;
+	case ResourceType::DistortionImage:
+		texture = effect->GetDistortionImage(ref.Index);
+		break;
+	case ResourceType::Model:
+	{
+		auto model = static_cast<EffekseerRendererUnity::Model*>(effect->GetModel(ref.Index));
+		return model != nullptr ? model->InternalPtr : nullptr;
+	}
+	case ResourceType::Material:
+	{
+		auto material = effect->GetMaterial(ref.Index);
+		if (material == nullptr || material->UserPtr == nullptr)
+		{
+			return nullptr;
+		}
+		return static_cast<EffekseerRendererUnity::Shader*>(material->UserPtr)->GetUnityMaterial();
+	}
+	case ResourceType::Background:
+		return background;
+	default:
+		return nullptr;
+	}
+
+	return texture != nullptr ? texture->UserPtr : nullptr;
+}
+
+std::unordered_map<void*, ResourceRef> CollectResources(Effekseer::Effect* effect, void* background)
+{
+	std::unordered_map<void*, ResourceRef> resources;
+
+	const ResourceType types[] = {ResourceType::ColorImage,
+								  ResourceType::NormalImage,
+								  ResourceType::DistortionImage,
+								  ResourceType::Model,
+								  ResourceType::Material,
+								  ResourceType::Background};
+
+	for (auto type : types)
+	{
+		auto count = GetResourceCount(effect, type);
+		for (int32_t i = 0; i < count; i++)
+		{
+			ResourceRef ref;
+			ref.Type = type;
+			ref.Index = i;
+
+			auto ptr = GetResource(effect, ref, background);
+			if (ptr != nullptr)
+			{
+				resources.emplace(ptr, ref);
+			}
+		}
+	}
+
+	return resources;
+}
+
+ResourceRef FindResource(const std::unordered_map<void*, ResourceRef>& resources, void* ptr)
+{
+	auto it = resources.find(ptr);
+	if (ptr == nullptr || it == resources.end())
+	{
+		ResourceRef ref;
+		ref.Type = ResourceType::None;
+		ref.Index = 0;
+		return ref;
+	}
+	return it->second;
+}
+
+void CaptureSegment(EffekseerRendererUnity::RendererImplemented* renderer,
+					const std::unordered_map<void*, ResourceRef>& resources,
+					BakedSegment& segment)
+{
+	for (const auto& rp : renderer->GetRenderParameters())
+	{
+		BakedParameter parameter;
+		memset(static_cast<void*>(&parameter), 0, sizeof(BakedParameter));
+		memcpy(static_cast<void*>(&parameter.Parameter), &rp, sizeof(UnityRenderParameter));
+
+		for (size_t i = 0; i < rp.TexturePtrs.size(); i++)
+		{
+			parameter.Textures[i] = FindResource(resources, rp.TexturePtrs[i]);
+			parameter.Parameter.TexturePtrs[i] = nullptr;
+		}
+
+		parameter.Model = FindResource(resources, rp.ModelPtr);
+		parameter.Material = FindResource(resources, rp.MaterialPtr);
+		parameter.Parameter.ModelPtr = nullptr;
+		parameter.Parameter.MaterialPtr = nullptr;
+
+		segment.Parameters.push_back(parameter);
+	}
+
+	segment.VertexBuffer = renderer->GetRenderVertexBuffer();
+	segment.InfoBuffer = renderer->GetRenderInfoBuffer();
+}
+
+//! offsets in clips are not trusted, so a range of count elements is checked without overflow
+bool IsInBuffer(int64_t offset, int64_t count, int64_t stride, size_t bufferSize)
+{
+	const auto size = static_cast<int64_t>(bufferSize);
+	if (offset < 0 || count < 0 || stride < 0 || offset > size)
+	{
+		return false;
+	}
+	return stride == 0 || count <= (size - offset) / stride;
+}
+
+bool IsValidSegment(const BakedSegment& segment)
+{
+	const int64_t customDataSize = sizeof(std::array<float, 4>);
+
+	for (const auto& parameter : segment.Parameters)
+	{
+		const auto& rp = parameter.Parameter;
+		const auto elementCount = static_cast<int64_t>(rp.ElementCount);
+
+		if (rp.RenderMode == 0)
+		{
+			if (rp.VertexBufferStride <= 0 ||
+				!IsInBuffer(rp.VertexBufferOffset, elementCount * 4, rp.VertexBufferStride, segment.VertexBuffer.size()))
+			{
+				return false;
+			}
+		}
+		else if (!IsInBuffer(rp.VertexBufferOffset,
+							 elementCount,
+							 EffekseerRendererUnity::RendererImplemented::GetModelParameterSize(),
+							 segment.InfoBuffer.size()))
+		{
+			return false;
+		}
+
+		if (rp.MaterialType == Effekseer::RendererMaterialType::File)
+		{
+			// a size of uniforms depends on a material, so it is checked when it is drawn
+			if (!IsInBuffer(rp.UniformBufferOffset, 0, 0, segment.InfoBuffer.size()))
+			{
+				return false;
+			}
+
+			// custom data of sprites is in vertices
+			if (rp.RenderMode != 0 && (!IsInBuffer(rp.CustomData1BufferOffset, elementCount, customDataSize, segment.InfoBuffer.size()) ||
+									   !IsInBuffer(rp.CustomData2BufferOffset, elementCount, customDataSize, segment.InfoBuffer.size())))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//! uniforms of a material must be in an info buffer
+bool IsValidUniforms(Effekseer::Effect* effect, const BakedParameter& baked, const std::vector<uint8_t>& infoBuffer)
+{
+	if (baked.Parameter.MaterialType != Effekseer::RendererMaterialType::File)
+	{
+		return true;
+	}
+
+	if (baked.Material.Type != ResourceType::Material || baked.Material.Index < 0 ||
+		baked.Material.Index >= GetResourceCount(effect, ResourceType::Material))
+	{
+		return false;
+	}
+
+	auto material = effect->GetMaterial(baked.Material.Index);
+	if (material == nullptr)
+	{
+		return false;
+	}
+
+	const int64_t uniformSize = sizeof(float) * 4;
+	return IsInBuffer(baked.Parameter.UniformBufferOffset, material->UniformCount, uniformSize, infoBuffer.size());
+}
+
+template <class T> void WriteValue(std::vector<uint8_t>& dst, const T& value)
+{
+	auto p = reinterpret_cast<const uint8_t*>(&value);
+	dst.insert(dst.end(), p, p + sizeof(T));
+}
+
+void WriteBytes(std::vector<uint8_t>& dst, const void* data, size_t size)
+{
+	auto p = static_cast<const uint8_t*>(data);
+	dst.insert(dst.end(), p, p + size);
+}
+
+class BinaryReader
+{
+private:
+	const uint8_t* data_;
+	size_t size_;
+	size_t position_ = 0;
+
+public:
+	BinaryReader(const void* data, size_t size) : data_(static_cast<const uint8_t*>(data)), size_(size) {}
+
+	bool Read(void* dst, size_t size)
+	{
+		if (position_ + size > size_)
+		{
+			return false;
+		}
+
+		if (size > 0)
+		{
+			memcpy(dst, data_ + position_, size);
+		}
+		position_ += size;
+		return true;
+	}
+
+	template <class T> bool ReadValue(T& value) { return Read(&value, sizeof(T)); }
+};
+
+std::vector<uint8_t> SerializeFrame(const BakedFrame& frame)
+{
+	std::vector<uint8_t> dst;
+
+	for (const auto& segment : frame)
+	{
+		WriteValue(dst, static_cast<int32_t>(segment.Parameters.size()));
+		WriteBytes(dst, segment.Parameters.data(), segment.Parameters.size() * sizeof(BakedParameter));
+		WriteValue(dst, static_cast<int32_t>(segment.VertexBuffer.size()));
+		WriteBytes(dst, segment.VertexBuffer.data(), segment.VertexBuffer.size());
+		WriteValue(dst, static_cast<int32_t>(segment.InfoBuffer.size()));
+		WriteBytes(dst, segment.InfoBuffer.data(), segment.InfoBuffer.size());
+	}
+
+	return dst;
+}
+
+bool DeserializeFrame(const std::vector<uint8_t>& src, BakedFrame& frame)
+{
+	BinaryReader reader(src.data(), src.size());
+
+	for (auto& segment : frame)
+	{
+		int32_t count = 0;
+
+		if (!reader.ReadValue(count) || count < 0 || static_cast<size_t>(count) > src.size() / sizeof(BakedParameter))
+		{
+			return false;
+		}
+		segment.Parameters.resize(count);
+		if (!reader.Read(segment.Parameters.data(), count * sizeof(BakedParameter)))
+		{
+			return false;
+		}
+
+		if (!reader.ReadValue(count) || count < 0 || static_cast<size_t>(count) > src.size())
+		{
+			return false;
+		}
+		segment.VertexBuffer.resize(count);
+		if (!reader.Read(segment.VertexBuffer.data(), count))
+		{
+			return false;
+		}
+
+		if (!reader.ReadValue(count) || count < 0 || static_cast<size_t>(count) > src.size())
+		{
+			return false;
+		}
+		segment.InfoBuffer.resize(count);
+		if (!reader.Read(segment.InfoBuffer.data(), count))
+		{
+			return false;
+		}
+
+		if (!IsValidSegment(segment))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//! xor bytes with a previous frame and encode runs of zero
+void Compress(const std::vector<uint8_t>& current, const std::vector<uint8_t>& previous, std::vector<uint8_t>& dst)
+{
+	auto delta = [&](size_t i) -> uint8_t { return current[i] ^ (i < previous.size() ? previous[i] : 0); };
+
+	size_t i = 0;
+	while (i < current.size())
+	{
+		uint16_t zeros = 0;
+		while (i < current.size() && zeros < UINT16_MAX && delta(i) == 0)
+		{
+			zeros++;
+			i++;
+		}
+
+		// a short run of zero is kept in literals
+		auto literalBegin = i;
+		while (i < current.size() && i - literalBegin < UINT16_MAX)
+		{
+			if (i + 3 < current.size() && delta(i) == 0 && delta(i + 1) == 0 && delta(i + 2) == 0 && delta(i + 3) == 0)
+			{
+				break;
+			}
+			i++;
+		}
+
+		WriteValue(dst, zeros);
+		WriteValue(dst, static_cast<uint16_t>(i - literalBegin));
+		for (auto k = literalBegin; k < i; k++)
+		{
+			dst.push_back(delta(k));
+		}
+	}
+}
+
+bool Decompress(BinaryReader& reader, int32_t size, const std::vector<uint8_t>& previous, std::vector<uint8_t>& dst)
+{
+	dst.resize(size);
+
+	size_t i = 0;
+	while (i < dst.size())
+	{
+		uint16_t zeros = 0;
+		uint16_t literals = 0;
+		if (!reader.ReadValue(zeros) || !reader.ReadValue(literals) || i + zeros + literals > dst.size())
+		{
+			return false;
+		}
+
+		for (auto end = i + zeros; i < end; i++)
+		{
+			dst[i] = i < previous.size() ? previous[i] : 0;
+		}
+
+		for (auto end = i + literals; i < end; i++)
+		{
+			uint8_t value = 0;
+			if (!reader.ReadValue(value))
+			{
+				return false;
+			}
+			dst[i] = value ^ (i < previous.size() ? previous[i] : 0);
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+struct BakedClips::BakedClip
+{
+	Effekseer::Effect* Effect = nullptr;
+	std::vector<BakedFrame> Frames;
+	float Time = 0.0f;
+	std::vector<Effekseer::Matrix44> Transforms;
+	std::vector<float> TimeOffsets;
+
+	~BakedClip() { ES_SAFE_RELEASE(Effect); }
+};
+
+std::shared_ptr<BakedClips> BakedClips::instance_;
+
+void BakedClips::Initialize() { instance_ = std::make_shared<BakedClips>(); }
+
+void BakedClips::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<BakedClips> BakedClips::GetInstance() { return instance_; }
+
+int32_t BakedClips::AddWithoutLock(const std::shared_ptr<BakedClip>& clip)
+{
+	auto id = nextId_++;
+	clips_[id] = clip;
+	return id;
+}
+
+int32_t BakedClips::Bake(Effekseer::Manager* manager,
+						 EffekseerRenderer::Renderer* renderer,
+						 Effekseer::Effect* effect,
+						 int32_t startFrame,
+						 int32_t frameCount)
+{
+	if (g_rendererType != RendererType::Unity || renderer == nullptr || frameCount <= 0)
+	{
+		return -1;
+	}
+
+	auto unityRenderer = static_cast<EffekseerRendererUnity::RendererImplemented*>(renderer);
+
+	auto handle = manager->Play(effect, Effekseer::Vector3D(), std::max(0, startFrame));
+	if (handle < 0)
+	{
+		return -1;
+	}
+	manager->SetAutoDrawing(handle, false);
+
+	auto resources = CollectResources(effect, unityRenderer->GetBackground());
+
+	auto clip = std::make_shared<BakedClip>();
+	clip->Frames.resize(frameCount);
+
+	Effekseer::Manager::DrawParameter drawParameter;
+	drawParameter.CameraCullingMask = -1;
+
+	for (auto& frame : clip->Frames)
+	{
+		unityRenderer->BeginRendering();
+		manager->DrawHandleBack(handle, drawParameter);
+		unityRenderer->EndRendering();
+		CaptureSegment(unityRenderer, resources, frame[0]);
+
+		unityRenderer->BeginRendering();
+		manager->DrawHandleFront(handle, drawParameter);
+		unityRenderer->EndRendering();
+		CaptureSegment(unityRenderer, resources, frame[1]);
+
+		manager->BeginUpdate();
+		manager->UpdateHandle(handle, 1.0f);
+		manager->EndUpdate();
+	}
+
+	manager->StopEffect(handle);
+
+	clip->Effect = effect;
+	ES_SAFE_ADDREF(clip->Effect);
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	return AddWithoutLock(clip);
+}
+
+int32_t BakedClips::Load(Effekseer::Effect* effect, const void* data, int32_t size)
+{
+	BinaryReader reader(data, size);
+
+	char magic[4];
+	int32_t version = 0;
+	int32_t parameterSize = 0;
+	int32_t frameCount = 0;
+
+	if (!reader.Read(magic, sizeof(magic)) || memcmp(magic, ClipMagic, sizeof(magic)) != 0)
+	{
+		return -1;
+	}
+
+	// a layout of parameters depends on a platform
+	if (!reader.ReadValue(version) || !reader.ReadValue(parameterSize) || !reader.ReadValue(frameCount) || version != ClipVersion ||
+		parameterSize != static_cast<int32_t>(sizeof(BakedParameter)) || frameCount <= 0)
+	{
+		return -1;
+	}
+
+	auto clip = std::make_shared<BakedClip>();
+	clip->Frames.resize(frameCount);
+
+	std::vector<uint8_t> previous;
+	std::vector<uint8_t> current;
+
+	for (auto& frame : clip->Frames)
+	{
+		int32_t frameSize = 0;
+		if (!reader.ReadValue(frameSize) || frameSize < 0 || frameSize > INT32_MAX / 2)
+		{
+			return -1;
+		}
+
+		if (!Decompress(reader, frameSize, previous, current) || !DeserializeFrame(current, frame))
+		{
+			return -1;
+		}
+
+		std::swap(previous, current);
+	}
+
+	clip->Effect = effect;
+	ES_SAFE_ADDREF(clip->Effect);
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	return AddWithoutLock(clip);
+}
+
+int32_t BakedClips::Save(int32_t id, void* data, int32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = clips_.find(id);
+	if (it == clips_.end())
+	{
+		return 0;
+	}
+
+	const auto& clip = *it->second;
+
+	std::vector<uint8_t> dst;
+	WriteBytes(dst, ClipMagic, sizeof(ClipMagic));
+	WriteValue(dst, ClipVersion);
+	WriteValue(dst, static_cast<int32_t>(sizeof(BakedParameter)));
+	WriteValue(dst, static_cast<int32_t>(clip.Frames.size()));
+
+	std::vector<uint8_t> previous;
+	for (const auto& frame : clip.Frames)
+	{
+		auto current = SerializeFrame(frame);
+		WriteValue(dst, static_cast<int32_t>(current.size()));
+		Compress(current, previous, dst);
+		std::swap(previous, current);
+	}
+
+	if (data != nullptr && size >= static_cast<int32_t>(dst.size()))
+	{
+		memcpy(data, dst.data(), dst.size());
+	}
+
+	return static_cast<int32_t>(dst.size());
+}
+
+void BakedClips::Destroy(int32_t id)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	clips_.erase(id);
+}
+
+void BakedClips::SetTransforms(int32_t id, const float* matrices, const float* timeOffsets, int32_t count)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = clips_.find(id);
+	if (it == clips_.end())
+	{
+		return;
+	}
+
+	auto& clip = *it->second;
+	count = std::max(count, 0);
+	clip.Transforms.resize(count);
+	clip.TimeOffsets.resize(count);
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		clip.Transforms[i] = ToMatrix44(matrices + i * 12);
+		clip.TimeOffsets[i] = timeOffsets != nullptr ? timeOffsets[i] : 0.0f;
+	}
+}
+
+void BakedClips::Update(float deltaFrame)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	for (auto& pair : clips_)
+	{
+		auto& clip = *pair.second;
+		clip.Time = std::fmod(clip.Time + deltaFrame, static_cast<float>(clip.Frames.size()));
+	}
+}
+
+void BakedClips::Draw(EffekseerRenderer::Renderer* renderer, InstancedDrawPass pass)
+{
+	auto clips = GetInstance();
+	if (clips == nullptr || renderer == nullptr || g_rendererType != RendererType::Unity)
+	{
+		return;
+	}
+
+	auto unityRenderer = static_cast<EffekseerRendererUnity::RendererImplemented*>(renderer);
+	auto background = unityRenderer->GetBackground();
+
+	std::lock_guard<std::mutex> lock(clips->mtx_);
+
+	std::map<int32_t, std::vector<Effekseer::Matrix44>> frameTransforms;
+	std::vector<UnityRenderParameter> parameters;
+
+	for (const auto& pair : clips->clips_)
+	{
+		const auto& clip = *pair.second;
+		const auto frameCount = static_cast<int32_t>(clip.Frames.size());
+
+		// instances are drawn together for each frame
+		frameTransforms.clear();
+		for (size_t i = 0; i < clip.Transforms.size(); i++)
+		{
+			auto frame = static_cast<int32_t>(std::floor(std::fmod(clip.Time + clip.TimeOffsets[i], static_cast<float>(frameCount))));
+			if (frame < 0)
+			{
+				frame += frameCount;
+			}
+			frameTransforms[std::min(std::max(frame, 0), frameCount - 1)].push_back(clip.Transforms[i]);
+		}
+
+		for (const auto& transforms : frameTransforms)
+		{
+			auto marker = unityRenderer->BeginInstancing();
+
+			for (int32_t s = 0; s < 2; s++)
+			{
+				if ((s == 0 && pass == InstancedDrawPass::Front) || (s == 1 && pass == InstancedDrawPass::Back))
+				{
+					continue;
+				}
+
+				const auto& segment = clip.Frames[transforms.first][s];
+
+				parameters.clear();
+				for (const auto& baked : segment.Parameters)
+				{
+					if (!IsValidUniforms(clip.Effect, baked, segment.InfoBuffer))
+					{
+						continue;
+					}
+
+					auto rp = baked.Parameter;
+					for (size_t t = 0; t < baked.Textures.size(); t++)
+					{
+						rp.TexturePtrs[t] = GetResource(clip.Effect, baked.Textures[t], background);
+					}
+					rp.ModelPtr = GetResource(clip.Effect, baked.Model, background);
+					rp.MaterialPtr = GetResource(clip.Effect, baked.Material, background);
+					parameters.push_back(rp);
+				}
+
+				unityRenderer->AppendExportedData(parameters, segment.VertexBuffer, segment.InfoBuffer);
+			}
+
+			unityRenderer->EndInstancing(marker, transforms.second);
+		}
+	}
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerBakeEffect(Effekseer::Effect* effect, int startFrame, int frameCount)
+	{
+		auto clips = BakedClips::GetInstance();
+		if (g_EffekseerManager == nullptr || g_EffekseerRenderer == nullptr || clips == nullptr || effect == nullptr)
+		{
+			return -1;
+		}
+
+		return clips->Bake(g_EffekseerManager, g_EffekseerRenderer, effect, startFrame, frameCount);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerLoadBakedClip(Effekseer::Effect* effect, const void* data, int size)
+	{
+		auto clips = BakedClips::GetInstance();
+		if (clips == nullptr || effect == nullptr || data == nullptr || size <= 0)
+		{
+			return -1;
+		}
+
+		return clips->Load(effect, data, size);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerSaveBakedClip(int id, void* data, int size)
+	{
+		auto clips = BakedClips::GetInstance();
+		if (clips == nullptr)
+		{
+			return 0;
+		}
+
+		return clips->Save(id, data, size);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetBakedClipTransforms(int id,
+																					  const float* matrices,
+																					  const float* timeOffsets,
+																					  int count)
+	{
+		auto clips = BakedClips::GetInstance();
+		if (clips == nullptr || count < 0 || (matrices == nullptr && count > 0))
+		{
+			return;
+		}
+
+		clips->SetTransforms(id, matrices, timeOffsets, count);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerDestroyBakedClip(int id)
+	{
+		auto clips = BakedClips::GetInstance();
+		if (clips == nullptr)
+		{
+			return;
+		}
+
+		clips->Destroy(id);
+	}
+}
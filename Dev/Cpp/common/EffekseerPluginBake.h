@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+#include "EffekseerPluginInstancing.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerRenderer
+{
+class Renderer;
+}
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	clips of exported data of the unity renderer which are played without simulation
+	@note
+	A clip captures render parameters and buffers of each frame of a loop and is drawn with transforms of instances.
+	It is valid only for effects which are deterministic and independent of a camera.
+	Resources are referred by indexes of an effect, so serialized data can be loaded in other runs.
+	Serialized frames are compressed with a delta from a previous frame and a run length encoding of zero.
+*/
+class BakedClips
+{
+private:
+	struct BakedClip;
+
+	std::mutex mtx_;
+	int32_t nextId_ = 0;
+	std::unordered_map<int32_t, std::shared_ptr<BakedClip>> clips_;
+
+	static std::shared_ptr<BakedClips> instance_;
+
+	int32_t AddWithoutLock(const std::shared_ptr<BakedClip>& clip);
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<BakedClips> GetInstance();
+
+	/**
+		@brief	capture frames of an effect. call it when effects are not rendered
+		@return	an id or -1
+	*/
+	int32_t Bake(Effekseer::Manager* manager,
+				 EffekseerRenderer::Renderer* renderer,
+				 Effekseer::Effect* effect,
+				 int32_t startFrame,
+				 int32_t frameCount);
+
+	//! return an id or -1
+	int32_t Load(Effekseer::Effect* effect, const void* data, int32_t size);
+
+	//! return a required size. data is written only if it is enough
+	int32_t Save(int32_t id, void* data, int32_t size);
+
+	void Destroy(int32_t id);
+
+	void SetTransforms(int32_t id, const float* matrices, const float* timeOffsets, int32_t count);
+
+	void Update(float deltaFrame);
+
+	//! draw instances of clips if it is initialized
+	static void Draw(EffekseerRenderer::Renderer* renderer, InstancedDrawPass pass);
+};
+
+} // namespace EffekseerPlugin
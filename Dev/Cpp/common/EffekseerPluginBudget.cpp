@@ -0,0 +1,343 @@
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+namespace
+{
+std::vector<Effekseer::Vector3D> GetCameraPositions()
+{
+	auto scheduler = UpdateScheduler::GetInstance();
+	if (scheduler == nullptr)
+	{
+		return std::vector<Effekseer::Vector3D>();
+	}
+	return scheduler->GetCameraPositions();
+}
+} // namespace
+
+std::shared_ptr<InstanceBudget> InstanceBudget::instance_;
+
+void InstanceBudget::Initialize() { instance_ = std::make_shared<InstanceBudget>(); }
+
+void InstanceBudget::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<InstanceBudget> InstanceBudget::GetInstance() { return instance_; }
+
+Effekseer::Handle
+InstanceBudget::Play(Effekseer::Manager* manager, Effekseer::Effect* effect, const Effekseer::Vector3D& position, int32_t startFrame)
+{
+	auto budget = GetInstance();
+	if (budget == nullptr)
+	{
+		return manager->Play(effect, position, startFrame);
+	}
+
+	std::lock_guard<std::mutex> lock(budget->mtx_);
+	return budget->PlayWithoutLock(manager, effect, position, startFrame);
+}
+
+int32_t InstanceBudget::GetLivingHandleCountWithoutLock() const
+{
+	int32_t count = 0;
+	for (const auto& pair : handles_)
+	{
+		if (!pair.second.IsEvicted)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+int32_t InstanceBudget::GetLivingInstanceCountWithoutLock(Effekseer::Manager* manager) const
+{
+	auto count = manager->GetTotalInstanceCount();
+	for (const auto& pair : handles_)
+	{
+		if (pair.second.IsEvicted)
+		{
+			count -= manager->GetInstanceCount(pair.first);
+		}
+	}
+	return count;
+}
+
+float InstanceBudget::CalculateImportance(int32_t priority,
+										  const Effekseer::Vector3D& position,
+										  const std::vector<Effekseer::Vector3D>& cameraPositions) const
+{
+	if (cameraPositions.empty() || distanceWeight_ == 0.0f)
+	{
+		return static_cast<float>(priority);
+	}
+
+	auto nearest = std::numeric_limits<float>::max();
+	for (const auto& cameraPosition : cameraPositions)
+	{
+		auto dx = position.X - cameraPosition.X;
+		auto dy = position.Y - cameraPosition.Y;
+		auto dz = position.Z - cameraPosition.Z;
+		nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy + dz * dz));
+	}
+
+	return priority - nearest * distanceWeight_;
+}
+
+int32_t InstanceBudget::EvictWithoutLock(Effekseer::Manager* manager,
+										 float maxImportance,
+										 const std::vector<Effekseer::Vector3D>& cameraPositions)
+{
+	int32_t leastHandle = -1;
+	auto leastImportance = maxImportance;
+
+	for (const auto& pair : handles_)
+	{
+		if (pair.second.IsEvicted)
+		{
+			continue;
+		}
+
+		auto importance = CalculateImportance(pair.second.Priority, manager->GetLocation(pair.first), cameraPositions);
+		if (importance < leastImportance)
+		{
+			leastHandle = pair.first;
+			leastImportance = importance;
+		}
+	}
+
+	if (leastHandle < 0)
+	{
+		return -1;
+	}
+
+	// existing particles are kept until they finish
+	manager->StopRoot(leastHandle);
+	handles_[leastHandle].IsEvicted = true;
+	evictedCount_++;
+
+	return manager->GetInstanceCount(leastHandle);
+}
+
+Effekseer::Handle InstanceBudget::PlayWithoutLock(Effekseer::Manager* manager,
+												  Effekseer::Effect* effect,
+												  const Effekseer::Vector3D& position,
+												  int32_t startFrame)
+{
+	int32_t priority = 0;
+	auto it = effectPriorities_.find(effect);
+	if (it != effectPriorities_.end())
+	{
+		priority = it->second;
+	}
+
+	if (IsEnabledWithoutLock())
+	{
+		auto isHandleExceeded = maxHandles_ > 0 && GetLivingHandleCountWithoutLock() >= maxHandles_;
+		auto isInstanceExceeded = maxInstances_ > 0 && GetLivingInstanceCountWithoutLock(manager) >= maxInstances_;
+
+		if (isHandleExceeded || isInstanceExceeded)
+		{
+			if (!isEvictionEnabled_)
+			{
+				refusedCount_++;
+				return -1;
+			}
+
+			auto cameraPositions = GetCameraPositions();
+			auto importance = CalculateImportance(priority, position, cameraPositions);
+			if (EvictWithoutLock(manager, importance, cameraPositions) < 0)
+			{
+				refusedCount_++;
+				return -1;
+			}
+		}
+	}
+
+	auto handle = manager->Play(effect, position, startFrame);
+	if (handle >= 0)
+	{
+		HandleState state;
+		state.Priority = priority;
+		handles_[handle] = state;
+	}
+
+	return handle;
+}
+
+void InstanceBudget::SetBudget(int32_t maxHandles, int32_t maxInstances, bool evictionEnabled, float distanceWeight)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	maxHandles_ = std::max(0, maxHandles);
+	maxInstances_ = std::max(0, maxInstances);
+	isEvictionEnabled_ = evictionEnabled;
+	distanceWeight_ = std::max(0.0f, distanceWeight);
+}
+
+void InstanceBudget::SetEffectPriority(Effekseer::Effect* effect, int32_t priority)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	effectPriorities_[effect] = priority;
+}
+
+void InstanceBudget::RemoveEffect(Effekseer::Effect* effect)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	effectPriorities_.erase(effect);
+}
+
+void InstanceBudget::Enforce(Effekseer::Manager* manager)
+{
+	auto cameraPositions = GetCameraPositions();
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::vector<int32_t> removed;
+	for (const auto& pair : handles_)
+	{
+		if (!manager->Exists(pair.first))
+		{
+			removed.push_back(pair.first);
+		}
+	}
+
+	for (auto handle : removed)
+	{
+		handles_.erase(handle);
+	}
+
+	if (!IsEnabledWithoutLock())
+	{
+		return;
+	}
+
+	const auto maxImportance = std::numeric_limits<float>::max();
+
+	if (maxHandles_ > 0)
+	{
+		auto count = GetLivingHandleCountWithoutLock();
+		while (count > maxHandles_ && EvictWithoutLock(manager, maxImportance, cameraPositions) >= 0)
+		{
+			count--;
+		}
+	}
+
+	if (maxInstances_ > 0)
+	{
+		auto count = GetLivingInstanceCountWithoutLock(manager);
+		while (count > maxInstances_)
+		{
+			auto evicted = EvictWithoutLock(manager, maxImportance, cameraPositions);
+			if (evicted < 0)
+			{
+				break;
+			}
+			count -= evicted;
+		}
+	}
+}
+
+void InstanceBudget::GetBudget(int32_t& maxHandles, int32_t& maxInstances)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	maxHandles = maxHandles_;
+	maxInstances = maxInstances_;
+}
+
+InstanceBudget::Stats InstanceBudget::GetStats(Effekseer::Manager* manager)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	Stats stats;
+	stats.HandleCount = GetLivingHandleCountWithoutLock();
+	stats.InstanceCount = manager->GetTotalInstanceCount();
+	stats.RefusedCount = refusedCount_;
+	stats.EvictedCount = evictedCount_;
+	return stats;
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetInstanceBudget(int maxHandles,
+																			   int maxInstances,
+																			   int evictionEnabled,
+																			   float distanceWeight)
+	{
+		auto budget = InstanceBudget::GetInstance();
+		if (budget == nullptr)
+		{
+			return;
+		}
+
+		budget->SetBudget(maxHandles, maxInstances, evictionEnabled != 0, distanceWeight);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetEffectPriority(Effekseer::Effect* effect, int priority)
+	{
+		auto budget = InstanceBudget::GetInstance();
+		if (budget == nullptr || effect == nullptr)
+		{
+			return;
+		}
+
+		budget->SetEffectPriority(effect, priority);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerGetInstanceBudget(int* maxHandles,
+																			   int* maxInstances,
+																			   int* handleCount,
+																			   int* instanceCount,
+																			   int* refusedCount,
+																			   int* evictedCount)
+	{
+		int32_t maxHandleValue = 0;
+		int32_t maxInstanceValue = 0;
+		InstanceBudget::Stats stats;
+
+		auto budget = InstanceBudget::GetInstance();
+		if (budget != nullptr && g_EffekseerManager != nullptr)
+		{
+			budget->GetBudget(maxHandleValue, maxInstanceValue);
+			stats = budget->GetStats(g_EffekseerManager);
+		}
+
+		if (maxHandles != nullptr)
+		{
+			*maxHandles = maxHandleValue;
+		}
+
+		if (maxInstances != nullptr)
+		{
+			*maxInstances = maxInstanceValue;
+		}
+
+		if (handleCount != nullptr)
+		{
+			*handleCount = stats.HandleCount;
+		}
+
+		if (instanceCount != nullptr)
+		{
+			*instanceCount = stats.InstanceCount;
+		}
+
+		if (refusedCount != nullptr)
+		{
+			*refusedCount = stats.RefusedCount;
+		}
+
+		if (evictedCount != nullptr)
+		{
+			*evictedCount = stats.EvictedCount;
+		}
+	}
+}
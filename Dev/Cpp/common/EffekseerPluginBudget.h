@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	limit the number of living handles and instances with priorities of effects
+	@note
+	Importance of a handle is its priority minus a distance to the nearest camera multiplied by a weight.
+	When a budget is exceeded, a new play is refused or the least important handle is stopped gracefully with StopRoot.
+	Only handles which are played through Play are tracked.
+*/
+class InstanceBudget
+{
+public:
+	struct Stats
+	{
+		int32_t HandleCount = 0;
+		int32_t InstanceCount = 0;
+		int32_t RefusedCount = 0;
+		int32_t EvictedCount = 0;
+	};
+
+private:
+	struct HandleState
+	{
+		int32_t Priority = 0;
+		bool IsEvicted = false;
+	};
+
+	std::mutex mtx_;
+	int32_t maxHandles_ = 0;
+	int32_t maxInstances_ = 0;
+	bool isEvictionEnabled_ = false;
+	float distanceWeight_ = 0.0f;
+	std::unordered_map<Effekseer::Effect*, int32_t> effectPriorities_;
+	std::unordered_map<int32_t, HandleState> handles_;
+	int32_t refusedCount_ = 0;
+	int32_t evictedCount_ = 0;
+
+	static std::shared_ptr<InstanceBudget> instance_;
+
+	bool IsEnabledWithoutLock() const { return maxHandles_ > 0 || maxInstances_ > 0; }
+
+	int32_t GetLivingHandleCountWithoutLock() const;
+
+	//! instances of evicted handles are not counted because they will disappear soon
+	int32_t GetLivingInstanceCountWithoutLock(Effekseer::Manager* manager) const;
+
+	float CalculateImportance(int32_t priority, const Effekseer::Vector3D& position, const std::vector<Effekseer::Vector3D>& cameraPositions) const;
+
+	//! stop the least important handle whose importance is lower than maxImportance. return the number of its instances
+	int32_t EvictWithoutLock(Effekseer::Manager* manager, float maxImportance, const std::vector<Effekseer::Vector3D>& cameraPositions);
+
+	Effekseer::Handle PlayWithoutLock(Effekseer::Manager* manager, Effekseer::Effect* effect, const Effekseer::Vector3D& position, int32_t startFrame);
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<InstanceBudget> GetInstance();
+
+	//! play an effect through a budget if it is initialized
+	static Effekseer::Handle Play(Effekseer::Manager* manager, Effekseer::Effect* effect, const Effekseer::Vector3D& position, int32_t startFrame = 0);
+
+	//! 0 means no limit
+	void SetBudget(int32_t maxHandles, int32_t maxInstances, bool evictionEnabled, float distanceWeight);
+
+	void SetEffectPriority(Effekseer::Effect* effect, int32_t priority);
+
+	void RemoveEffect(Effekseer::Effect* effect);
+
+	//! drop removed handles and stop handles while instances exceed a budget. call after Manager::Update
+	void Enforce(Effekseer::Manager* manager);
+
+	void GetBudget(int32_t& maxHandles, int32_t& maxInstances);
+
+	Stats GetStats(Effekseer::Manager* manager);
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,260 @@
+#include "EffekseerPluginBundle.h"
+#include "EffekseerPluginNetwork.h"
+#include "MemoryFile.h"
+#include <algorithm>
+#include <string.h>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+bool EffectBundle::Parse()
+{
+	using namespace BundleFormat;
+
+	auto data = file_->GetData();
+	auto size = static_cast<uint64_t>(file_->GetSize());
+	if (size < sizeof(Header))
+	{
+		return false;
+	}
+
+	Header header;
+	memcpy(&header, data, sizeof(Header));
+
+	if (memcmp(header.Magic, Magic, sizeof(Magic)) != 0 || header.Version != Version)
+	{
+		return false;
+	}
+
+	// check ranges before they are read
+	const uint64_t entriesEnd = sizeof(Header) + static_cast<uint64_t>(header.EntryCount) * sizeof(Entry);
+	if (entriesEnd > size || header.PathsOffset < entriesEnd || header.PathsOffset > size || header.PathsSize > size - header.PathsOffset ||
+		header.PathsOffset % sizeof(char16_t) != 0)
+	{
+		return false;
+	}
+
+	entries_ = reinterpret_cast<const Entry*>(data + sizeof(Header));
+	entryCount_ = header.EntryCount;
+	paths_ = data + header.PathsOffset;
+
+	const uint64_t pathCount = header.PathsSize / sizeof(char16_t);
+	for (uint32_t i = 0; i < entryCount_; i++)
+	{
+		const auto& entry = entries_[i];
+		if (static_cast<uint64_t>(entry.PathOffset) + entry.PathLength > pathCount || entry.DataOffset > size ||
+			entry.DataSize > size - entry.DataOffset)
+		{
+			return false;
+		}
+
+		if (i > 0 && entries_[i - 1].PathHash > entry.PathHash)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::shared_ptr<EffectBundle> EffectBundle::Open(const char16_t* path)
+{
+	auto files = MappedFiles::GetInstance();
+	auto file = files != nullptr ? files->Open(path) : MappedFile::Open(path);
+	if (file == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto bundle = std::make_shared<EffectBundle>();
+	bundle->file_ = file;
+	if (!bundle->Parse())
+	{
+		return nullptr;
+	}
+	return bundle;
+}
+
+bool EffectBundle::Find(const char16_t* path, const uint8_t*& data, size_t& size) const
+{
+	using namespace BundleFormat;
+
+	if (path == nullptr)
+	{
+		return false;
+	}
+
+	const auto normalized = NormalizePath(path);
+	const auto hash = HashPath(normalized);
+
+	auto entriesEnd = entries_ + entryCount_;
+	auto it = std::lower_bound(entries_, entriesEnd, hash, [](const Entry& entry, uint64_t value) { return entry.PathHash < value; });
+
+	// compare paths because hashes may collide
+	for (; it != entriesEnd && it->PathHash == hash; it++)
+	{
+		if (it->PathLength != normalized.size() ||
+			memcmp(paths_ + static_cast<size_t>(it->PathOffset) * sizeof(char16_t), normalized.data(), normalized.size() * sizeof(char16_t)) !=
+				0)
+		{
+			continue;
+		}
+
+		data = file_->GetData() + it->DataOffset;
+		size = static_cast<size_t>(it->DataSize);
+		return true;
+	}
+
+	return false;
+}
+
+std::shared_ptr<EffectBundles> EffectBundles::instance_;
+
+void EffectBundles::Initialize() { instance_ = std::make_shared<EffectBundles>(); }
+
+void EffectBundles::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<EffectBundles> EffectBundles::GetInstance() { return instance_; }
+
+int32_t EffectBundles::Open(const char16_t* path)
+{
+	auto bundle = EffectBundle::Open(path);
+	if (bundle == nullptr)
+	{
+		return -1;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	auto id = nextId_++;
+	bundles_.emplace_back(id, bundle);
+	return id;
+}
+
+void EffectBundles::Close(int32_t id)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = std::find_if(bundles_.begin(), bundles_.end(), [id](const std::pair<int32_t, std::shared_ptr<EffectBundle>>& bundle) {
+		return bundle.first == id;
+	});
+
+	if (it != bundles_.end())
+	{
+		bundles_.erase(it);
+	}
+}
+
+std::shared_ptr<EffectBundle> EffectBundles::Get(int32_t id)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	for (const auto& bundle : bundles_)
+	{
+		if (bundle.first == id)
+		{
+			return bundle.second;
+		}
+	}
+	return nullptr;
+}
+
+std::shared_ptr<EffectBundle> EffectBundles::Find(const char16_t* path, const uint8_t*& data, size_t& size)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	for (auto it = bundles_.rbegin(); it != bundles_.rend(); it++)
+	{
+		if (it->second->Find(path, data, size))
+		{
+			return it->second;
+		}
+	}
+	return nullptr;
+}
+
+std::shared_ptr<EffectBundle> EffectBundles::FindInAll(const char16_t* path, const uint8_t*& data, size_t& size)
+{
+	auto bundles = GetInstance();
+	if (bundles == nullptr)
+	{
+		return nullptr;
+	}
+	return bundles->Find(path, data, size);
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerOpenBundle(const EFK_CHAR* path)
+	{
+		auto bundles = EffectBundles::GetInstance();
+		if (bundles == nullptr || path == nullptr)
+		{
+			return -1;
+		}
+
+		return bundles->Open((const char16_t*)path);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerCloseBundle(int id)
+	{
+		auto bundles = EffectBundles::GetInstance();
+		if (bundles == nullptr)
+		{
+			return;
+		}
+
+		bundles->Close(id);
+	}
+
+	UNITY_INTERFACE_EXPORT Effekseer::Effect* UNITY_INTERFACE_API EffekseerLoadEffectFromBundle(int id,
+																							  const EFK_CHAR* path,
+																							  float magnification)
+	{
+		auto bundles = EffectBundles::GetInstance();
+		auto bundle = bundles != nullptr ? bundles->Get(id) : nullptr;
+		if (g_EffekseerManager == nullptr || bundle == nullptr)
+		{
+			return nullptr;
+		}
+
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		if (!bundle->Find((const char16_t*)path, data, size))
+		{
+			return nullptr;
+		}
+
+		MemoryBufferPool::Buffer decompressed;
+		if (!DecompressIfCompressed(data, size, decompressed))
+		{
+			return nullptr;
+		}
+
+		// resources are referred relative to an effect and resolved from bundles by loaders
+		auto normalized = BundleFormat::NormalizePath((const char16_t*)path);
+		auto directory = normalized.substr(0, normalized.find_last_of(u'/') + 1);
+
+		auto effect = Effekseer::Effect::Create(
+			g_EffekseerManager, const_cast<uint8_t*>(data), static_cast<int32_t>(size), magnification, (const EFK_CHAR*)directory.c_str());
+		if (effect == nullptr)
+		{
+			return nullptr;
+		}
+
+		effect->SetName(path);
+
+#ifndef _SWITCH
+		if (Network::GetInstance()->IsRunning())
+		{
+			Network::GetInstance()->Register(effect->GetName(), effect);
+		}
+#endif
+
+		return effect;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginBundleFormat.h"
+#include "EffekseerPluginCommon.h"
+#include "EffekseerPluginMappedFile.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a bundle (.efkpkg) which is mapped into memory
+*/
+class EffectBundle
+{
+private:
+	std::shared_ptr<MappedFile> file_;
+	const BundleFormat::Entry* entries_ = nullptr;
+	uint32_t entryCount_ = 0;
+	const uint8_t* paths_ = nullptr;
+
+	bool Parse();
+
+public:
+	//! return null if a file is not a valid bundle
+	static std::shared_ptr<EffectBundle> Open(const char16_t* path);
+
+	//! find data of a path with a binary search of hashes
+	bool Find(const char16_t* path, const uint8_t*& data, size_t& size) const;
+
+	int32_t GetEntryCount() const { return static_cast<int32_t>(entryCount_); }
+};
+
+/**
+	@brief	opened bundles which resources of effects are resolved from before Unity is called
+	@note
+	A bundle which is opened later is searched first.
+*/
+class EffectBundles
+{
+private:
+	std::mutex mtx_;
+	int32_t nextId_ = 0;
+	std::vector<std::pair<int32_t, std::shared_ptr<EffectBundle>>> bundles_;
+
+	static std::shared_ptr<EffectBundles> instance_;
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<EffectBundles> GetInstance();
+
+	//! return an id or -1
+	int32_t Open(const char16_t* path);
+
+	void Close(int32_t id);
+
+	std::shared_ptr<EffectBundle> Get(int32_t id);
+
+	/**
+		@brief	find data of a path in all bundles
+		@return	a bundle which keeps data or null
+	*/
+	std::shared_ptr<EffectBundle> Find(const char16_t* path, const uint8_t*& data, size_t& size);
+
+	//! find data in opened bundles if they are initialized
+	static std::shared_ptr<EffectBundle> FindInAll(const char16_t* path, const uint8_t*& data, size_t& size);
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a layout of a bundle (.efkpkg) which packs effects and their resources
+	@note
+	A bundle consists of a header, entries sorted by hashes of paths, paths in UTF-16 and data.
+	Each data is aligned with DataAlignment bytes. Values are little endian.
+	Paths are relative to a root of a bundle, separated with '/', collapsed and case sensitive.
+	It is shared with the bundle builder, so it must not depend on Effekseer.
+*/
+namespace BundleFormat
+{
+
+const uint8_t Magic[8] = {'E', 'F', 'K', 'P', 'K', 'G', 0, 0};
+
+const uint32_t Version = 1;
+
+const uint32_t DataAlignment = 16;
+
+struct Header
+{
+	uint8_t Magic[8];
+	uint32_t Version;
+	uint32_t EntryCount;
+	uint64_t PathsOffset;
+	uint64_t PathsSize;
+};
+
+struct Entry
+{
+	uint64_t PathHash;
+	//! an offset from PathsOffset in characters
+	uint32_t PathOffset;
+	uint32_t PathLength;
+	uint64_t DataOffset;
+	uint64_t DataSize;
+};
+
+static_assert(sizeof(Header) == 32, "a header must not be padded");
+static_assert(sizeof(Entry) == 32, "an entry must not be padded");
+
+/**
+	@brief	replace separators, remove a leading "/" and collapse "." and ".." segments
+	@note
+	Effects refer resources such as "../Textures/a.png", so "fx/../Textures/a.png" must be same as "Textures/a.png".
+	".." which goes above a root is kept, so that it matches nothing.
+*/
+inline std::u16string NormalizePath(const char16_t* path)
+{
+	std::u16string ret;
+	std::u16string segment;
+
+	for (auto p = path;; p++)
+	{
+		if (*p != 0 && *p != u'/' && *p != u'\\')
+		{
+			segment.push_back(*p);
+			continue;
+		}
+
+		if (segment == u"..")
+		{
+			const auto last = ret.rfind(u'/');
+			const auto lastSegment = last == std::u16string::npos ? ret : ret.substr(last + 1);
+			if (ret.empty() || lastSegment == u"..")
+			{
+				ret += ret.empty() ? u".." : u"/..";
+			}
+			else
+			{
+				ret.erase(last == std::u16string::npos ? 0 : last);
+			}
+		}
+		else if (!segment.empty() && segment != u".")
+		{
+			if (!ret.empty())
+			{
+				ret.push_back(u'/');
+			}
+			ret += segment;
+		}
+		segment.clear();
+
+		if (*p == 0)
+		{
+			break;
+		}
+	}
+
+	return ret;
+}
+
+//! FNV-1a of characters of a normalized path
+inline uint64_t HashPath(const std::u16string& path)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (auto c : path)
+	{
+		hash ^= static_cast<uint64_t>(c & 0xFF);
+		hash *= 1099511628211ULL;
+		hash ^= static_cast<uint64_t>(c >> 8);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+} // namespace BundleFormat
+
+} // namespace EffekseerPlugin
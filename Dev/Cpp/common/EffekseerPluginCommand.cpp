@@ -0,0 +1,314 @@
+#include "EffekseerPluginCommand.h"
+#include "EffekseerPluginScheduler.h"
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginMaterial.h"
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+namespace
+{
+
+class CommandReader
+{
+	const uint8_t* data_ = nullptr;
+	int32_t size_ = 0;
+	int32_t position_ = 0;
+
+public:
+	CommandReader(const void* data, int32_t size) : data_(static_cast<const uint8_t*>(data)), size_(size) {}
+
+	bool IsEnd() const { return position_ >= size_; }
+
+	template <typename T> bool Read(T& value)
+	{
+		if (position_ + static_cast<int32_t>(sizeof(T)) > size_)
+		{
+			return false;
+		}
+
+		memcpy(&value, data_ + position_, sizeof(T));
+		position_ += sizeof(T);
+		return true;
+	}
+
+	template <typename T0, typename... T> bool Read(T0& value, T&... values) { return Read(value) && Read(values...); }
+};
+
+} // namespace
+
+void Array2Matrix43(Effekseer::Matrix43& matrix, const float* matrixArray)
+{
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			matrix.Value[r][c] = matrixArray[r * 3 + c];
+		}
+	}
+}
+
+int32_t ExecuteCommands(Effekseer::Manager* manager, const void* buffer, int32_t size, int32_t* outHandles, int32_t outHandleCount)
+{
+	if (manager == nullptr || buffer == nullptr || size <= 0)
+	{
+		return 0;
+	}
+
+	CommandReader reader(buffer, size);
+	int32_t executed = 0;
+
+	while (!reader.IsEnd())
+	{
+		CommandType type;
+		if (!reader.Read(type))
+		{
+			return -1;
+		}
+
+		int32_t handle = -1;
+
+		switch (type)
+		{
+		case CommandType::Play:
+		{
+			uint64_t effect = 0;
+			float x, y, z;
+			int32_t outputIndex = -1;
+			if (!reader.Read(effect, x, y, z, outputIndex))
+				return -1;
+
+			auto effectPtr = reinterpret_cast<Effekseer::Effect*>(static_cast<uintptr_t>(effect));
+			int32_t played = (effectPtr != nullptr) ? InstanceBudget::Play(manager, effectPtr, Effekseer::Vector3D(x, y, z)) : -1;
+			MaterialEvent::OnPlayed(manager, effectPtr, played);
+
+			if (outHandles != nullptr && outputIndex >= 0 && outputIndex < outHandleCount)
+			{
+				outHandles[outputIndex] = played;
+			}
+			break;
+		}
+		case CommandType::Stop:
+			if (!reader.Read(handle))
+				return -1;
+			manager->StopEffect(handle);
+			break;
+		case CommandType::StopRoot:
+			if (!reader.Read(handle))
+				return -1;
+			manager->StopRoot(handle);
+			break;
+		case CommandType::SetLocation:
+		{
+			float x, y, z;
+			if (!reader.Read(handle, x, y, z))
+				return -1;
+			manager->SetLocation(handle, x, y, z);
+			break;
+		}
+		case CommandType::SetRotation:
+		{
+			float x, y, z, angle;
+			if (!reader.Read(handle, x, y, z, angle))
+				return -1;
+			manager->SetRotation(handle, Effekseer::Vector3D(x, y, z), angle);
+			break;
+		}
+		case CommandType::SetScale:
+		{
+			float x, y, z;
+			if (!reader.Read(handle, x, y, z))
+				return -1;
+			manager->SetScale(handle, x, y, z);
+			break;
+		}
+		case CommandType::SetAllColor:
+		{
+			int32_t r, g, b, a;
+			if (!reader.Read(handle, r, g, b, a))
+				return -1;
+			manager->SetAllColor(handle, Effekseer::Color(r, g, b, a));
+			break;
+		}
+		case CommandType::SetTargetLocation:
+		{
+			float x, y, z;
+			if (!reader.Read(handle, x, y, z))
+				return -1;
+			manager->SetTargetLocation(handle, x, y, z);
+			break;
+		}
+		case CommandType::SetDynamicInput:
+		{
+			int32_t index;
+			float value;
+			if (!reader.Read(handle, index, value))
+				return -1;
+			manager->SetDynamicInput(handle, index, value);
+			break;
+		}
+		case CommandType::SetSpeed:
+		{
+			float speed;
+			if (!reader.Read(handle, speed))
+				return -1;
+			UpdateScheduler::SetSpeed(manager, handle, speed);
+			break;
+		}
+		case CommandType::SetPaused:
+		{
+			int32_t paused;
+			if (!reader.Read(handle, paused))
+				return -1;
+			manager->SetPaused(handle, paused != 0);
+			break;
+		}
+		case CommandType::SetShown:
+		{
+			int32_t shown;
+			if (!reader.Read(handle, shown))
+				return -1;
+			MaterialEvent::SetShown(manager, handle, shown != 0);
+			break;
+		}
+		case CommandType::SetLayer:
+		{
+			int32_t layer;
+			if (!reader.Read(handle, layer))
+				return -1;
+			manager->SetLayer(handle, layer);
+			break;
+		}
+		case CommandType::SetMatrix:
+		{
+			float values[12];
+			if (!reader.Read(handle, values))
+				return -1;
+
+			Effekseer::Matrix43 matrix;
+			Array2Matrix43(matrix, values);
+			manager->SetMatrix(handle, matrix);
+			break;
+		}
+		default:
+			// unknown opcode, the rest of the buffer can't be decoded
+			return -1;
+		}
+
+		executed++;
+	}
+
+	return executed;
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerSubmitCommands(const void* buffer, int size, int* outHandles, int outHandleCount)
+	{
+		if (g_EffekseerManager == nullptr)
+		{
+			return 0;
+		}
+
+		return ExecuteCommands(g_EffekseerManager, buffer, size, outHandles, outHandleCount);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetMatrices(const int* handles, const float* matrices4x3, int count)
+	{
+		if (g_EffekseerManager == nullptr || handles == nullptr || matrices4x3 == nullptr)
+		{
+			return;
+		}
+
+		Effekseer::Matrix43 matrix;
+		for (int i = 0; i < count; i++)
+		{
+			if (handles[i] < 0)
+				continue;
+
+			Array2Matrix43(matrix, matrices4x3 + i * 12);
+			g_EffekseerManager->SetMatrix(handles[i], matrix);
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerQueryHandles(const int* handles, int count, uint8_t* outFlags, int* outInstanceCounts)
+	{
+		if (handles == nullptr || outFlags == nullptr)
+		{
+			return;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			uint8_t flags = 0;
+			int instanceCount = 0;
+
+			if (g_EffekseerManager != nullptr && handles[i] >= 0)
+			{
+				if (g_EffekseerManager->Exists(handles[i]))
+				{
+					flags |= static_cast<uint8_t>(HandleFlags::Exists);
+
+					if (MaterialEvent::GetShown(g_EffekseerManager, handles[i]))
+						flags |= static_cast<uint8_t>(HandleFlags::Shown);
+
+					if (g_EffekseerManager->GetPaused(handles[i]))
+						flags |= static_cast<uint8_t>(HandleFlags::Paused);
+
+					if (outInstanceCounts != nullptr)
+						instanceCount = g_EffekseerManager->GetInstanceCount(handles[i]);
+				}
+				else
+				{
+					flags |= static_cast<uint8_t>(HandleFlags::Finished);
+				}
+			}
+
+			outFlags[i] = flags;
+
+			if (outInstanceCounts != nullptr)
+			{
+				outInstanceCounts[i] = instanceCount;
+			}
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerPlayEffects(
+		Effekseer::Effect* effect, const float* positions, int count, const int* startFrames, const int* layers, int* outHandles)
+	{
+		if (outHandles == nullptr)
+		{
+			return;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			outHandles[i] = -1;
+		}
+
+		if (g_EffekseerManager == nullptr || effect == nullptr || positions == nullptr)
+		{
+			return;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			Effekseer::Vector3D position(positions[i * 3 + 0], positions[i * 3 + 1], positions[i * 3 + 2]);
+			int32_t startFrame = (startFrames != nullptr) ? startFrames[i] : 0;
+
+			auto handle = InstanceBudget::Play(g_EffekseerManager, effect, position, startFrame);
+			MaterialEvent::OnPlayed(g_EffekseerManager, effect, handle);
+			if (handle >= 0 && layers != nullptr)
+			{
+				g_EffekseerManager->SetLayer(handle, layers[i]);
+			}
+
+			outHandles[i] = handle;
+		}
+	}
+}
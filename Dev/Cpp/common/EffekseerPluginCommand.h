@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	opcodes of a packed command buffer
+	@note
+	A command is an int32 opcode followed by its arguments.
+	All arguments are 4 bytes (int32 or float) except an effect pointer, which is always stored as 8 bytes.
+	The values must be same as Plugin.CommandType in Effekseer.cs.
+*/
+enum class CommandType : int32_t
+{
+	//! effect(ptr64), x, y, z, outputIndex
+	Play = 0,
+	//! handle
+	Stop = 1,
+	//! handle
+	StopRoot = 2,
+	//! handle, x, y, z
+	SetLocation = 3,
+	//! handle, axisX, axisY, axisZ, angle
+	SetRotation = 4,
+	//! handle, x, y, z
+	SetScale = 5,
+	//! handle, r, g, b, a
+	SetAllColor = 6,
+	//! handle, x, y, z
+	SetTargetLocation = 7,
+	//! handle, index, value
+	SetDynamicInput = 8,
+	//! handle, speed
+	SetSpeed = 9,
+	//! handle, paused
+	SetPaused = 10,
+	//! handle, shown
+	SetShown = 11,
+	//! handle, layer
+	SetLayer = 12,
+	//! handle, matrix(float x 12)
+	SetMatrix = 13,
+};
+
+/**
+	@brief	state flags returned by EffekseerQueryHandles
+	@note
+	The values must be same as Plugin.HandleFlags in Effekseer.cs.
+*/
+enum class HandleFlags : uint8_t
+{
+	Exists = 1 << 0,
+	Shown = 1 << 1,
+	Paused = 1 << 2,
+	//! the handle is not negative but not alive. it is not distinguished from a handle which never existed
+	Finished = 1 << 3,
+};
+
+/**
+	@brief	convert an array of 12 floats into a matrix
+	@note
+	The layout is same as Effekseer::Matrix43. Rows 0-2 are X, Y and Z axis and row 3 is translation.
+*/
+void Array2Matrix43(Effekseer::Matrix43& matrix, const float* matrixArray);
+
+/**
+	@brief	execute commands in a packed buffer
+	@return	the number of executed commands, or -1 if the buffer is broken
+*/
+int32_t ExecuteCommands(Effekseer::Manager* manager, const void* buffer, int32_t size, int32_t* outHandles, int32_t outHandleCount);
+
+} // namespace EffekseerPlugin
@@ -1,8 +1,17 @@
 #include "EffekseerPluginCommon.h"
 #include "EffekseerPluginTexture.h"
 #include "EffekseerPluginModel.h"
+#include "EffekseerPluginMaterial.h"
 #include "EffekseerPluginSound.h"
 #include "EffekseerPluginNetwork.h"
+#include "EffekseerPluginGroup.h"
+#include "EffekseerPluginScheduler.h"
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginSeek.h"
+#include "EffekseerPluginBake.h"
+#include "EffekseerPluginAsync.h"
+#include "EffekseerPluginEffectCache.h"
+#include "MemoryFile.h"
 #include "../graphicsAPI/EffekseerPluginGraphics.h"
 
 using namespace Effekseer;
@@ -75,9 +84,45 @@ extern "C"
 		if (g_EffekseerManager == NULL) {
 			return;
 		}
+
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler != nullptr)
+		{
+			scheduler->BeginUpdate(g_EffekseerManager, deltaFrame);
+		}
 		
 		g_EffekseerManager->Update(deltaFrame);
-		
+
+		if (scheduler != nullptr)
+		{
+			scheduler->EndUpdate(g_EffekseerManager);
+		}
+
+		auto budget = InstanceBudget::GetInstance();
+		if (budget != nullptr)
+		{
+			budget->Enforce(g_EffekseerManager);
+		}
+
+		MaterialEvent::ShowLoadedHandles(g_EffekseerManager);
+
+		auto groups = EffectGroups::GetInstance();
+		if (groups != nullptr)
+		{
+			groups->Sweep(g_EffekseerManager);
+		}
+
+		auto seekable = SeekableHandles::GetInstance();
+		if (seekable != nullptr)
+		{
+			seekable->Sweep(g_EffekseerManager);
+		}
+
+		auto clips = BakedClips::GetInstance();
+		if (clips != nullptr)
+		{
+			clips->Update(deltaFrame);
+		}
 	}
 	
 	UNITY_INTERFACE_EXPORT Effect* UNITY_INTERFACE_API EffekseerLoadEffect(const EFK_CHAR* path, float magnification)
@@ -104,12 +149,39 @@ extern "C"
 																				   const EFK_CHAR* path,
 																				   float magnification)
 	{
-		if (g_EffekseerManager == NULL) {
+		if (g_EffekseerManager == NULL || data == NULL || size <= 0) {
+			return NULL;
+		}
+
+		// the same data which is already loaded is shared
+		auto cache = EffectCache::GetInstance();
+		EffectCache::Key key;
+		if (cache != nullptr) {
+			key = EffectCache::CreateKey(data, size, magnification);
+			auto cachedEffect = cache->Find(key);
+			if (cachedEffect != nullptr) {
+				return cachedEffect;
+			}
+		}
+
+		// a compressed container is decompressed before it is parsed
+		const uint8_t* rawData = static_cast<const uint8_t*>(data);
+		size_t rawSize = static_cast<size_t>(size);
+		MemoryBufferPool::Buffer decompressed;
+		if (!DecompressIfCompressed(rawData, rawSize, decompressed)) {
 			return NULL;
 		}
 		
-		auto effect = Effect::Create(g_EffekseerManager, data, size, magnification);
+		auto effect = Effect::Create(g_EffekseerManager, const_cast<uint8_t*>(rawData), static_cast<int32_t>(rawSize), magnification);
 		
+		if (effect != nullptr && cache != nullptr)
+		{
+			auto sharedEffect = cache->Add(key, effect);
+			if (sharedEffect != effect) {
+				return sharedEffect;
+			}
+		}
+
 		if (effect != nullptr)
 		{
 			effect->SetName(path);
@@ -129,6 +201,13 @@ extern "C"
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerReleaseEffect(Effect* effect)
 	{
 		if (effect != NULL) {
+			// other loads of the same data still use it
+			auto cache = EffectCache::GetInstance();
+			if (cache != nullptr && cache->Release(effect) > 0) {
+				effect->Release();
+				return;
+			}
+
 #ifndef _SWITCH
 			if (Network::GetInstance()->IsRunning())
 			{
@@ -136,6 +215,12 @@ extern "C"
 			}
 #endif
 
+			auto budget = InstanceBudget::GetInstance();
+			if (budget != nullptr)
+			{
+				budget->RemoveEffect(effect);
+			}
+
 			effect->Release();
 		}
 	}
@@ -156,6 +241,48 @@ extern "C"
 		}
 	}
 
+	// prewarm an effect by playing hidden handles for a frame
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerPrewarmEffect(Effect* effect, int count)
+	{
+		if (g_EffekseerManager == NULL || effect == NULL) {
+			return 0;
+		}
+
+		std::vector<Handle> handles;
+
+		for (int i = 0; i < count; i++)
+		{
+			auto handle = g_EffekseerManager->Play(effect, 0.0f, 0.0f, 0.0f);
+			if (handle < 0)
+			{
+				break;
+			}
+			MaterialEvent::OnPlayed(g_EffekseerManager, effect, handle);
+
+			MaterialEvent::SetShown(g_EffekseerManager, handle, false);
+			handles.push_back(handle);
+		}
+
+		// instances and resources are touched by the first frame
+		EffekseerPlugin::SoundPlayer::SetMuted(true);
+
+		g_EffekseerManager->BeginUpdate();
+		for (auto handle : handles)
+		{
+			g_EffekseerManager->UpdateHandle(handle, 1.0f);
+		}
+		g_EffekseerManager->EndUpdate();
+
+		EffekseerPlugin::SoundPlayer::SetMuted(false);
+
+		for (auto handle : handles)
+		{
+			g_EffekseerManager->StopEffect(handle);
+		}
+
+		return static_cast<int>(handles.size());
+	}
+
 	UNITY_INTERFACE_EXPORT float UNITY_INTERFACE_API EffekseerGetEffectMagnification(Effect* effect)
 	{ 
 		if (effect != nullptr)
@@ -173,7 +300,24 @@ extern "C"
 		}
 
 		if (effect != NULL) {
-			return g_EffekseerManager->Play(effect, x, y, z);
+			auto handle = InstanceBudget::Play(g_EffekseerManager, effect, Vector3D(x, y, z));
+			MaterialEvent::OnPlayed(g_EffekseerManager, effect, handle);
+			return handle;
+		}
+		return -1;
+	}
+
+	// play from the specified frame
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerPlayEffectAtFrame(Effect* effect, float x, float y, float z, int startFrame)
+	{
+		if (g_EffekseerManager == NULL) {
+			return -1;
+		}
+
+		if (effect != NULL) {
+			auto handle = InstanceBudget::Play(g_EffekseerManager, effect, Vector3D(x, y, z), startFrame);
+			MaterialEvent::OnPlayed(g_EffekseerManager, effect, handle);
+			return handle;
 		}
 		return -1;
 	}
@@ -244,7 +388,7 @@ extern "C"
 			return 0;
 		}
 
-		return g_EffekseerManager->GetShown(handle);
+		return MaterialEvent::GetShown(g_EffekseerManager, handle);
 	}
 
 	// GtFNgݒ
@@ -254,7 +398,7 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetShown(handle, shown != 0);
+		MaterialEvent::SetShown(g_EffekseerManager, handle, shown != 0);
 	}
 
 	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetPaused(int handle)
@@ -282,7 +426,7 @@ extern "C"
 			return 0;
 		}
 
-		return g_EffekseerManager->GetSpeed(handle);
+		return UpdateScheduler::GetSpeed(g_EffekseerManager, handle);
 	}
 
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetSpeed(int handle, float speed)
@@ -291,7 +435,7 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetSpeed(handle, speed);
+		UpdateScheduler::SetSpeed(g_EffekseerManager, handle, speed);
 	}
 	
 	// GtFNgݏ
@@ -420,6 +564,12 @@ extern "C"
 		if (renderId >= 0 && renderId < MAX_RENDER_PATH) {
 			Array2Matrix(renderSettings[renderId].cameraMatrix, matrixArray);
 			renderSettings[renderId].stereoEnabled = false;
+
+			auto scheduler = UpdateScheduler::GetInstance();
+			if (scheduler != nullptr)
+			{
+				scheduler->NotifyCamera(renderId);
+			}
 		}
 	}
 
@@ -439,6 +589,12 @@ extern "C"
 			Array2Matrix(settings.rightProjectionMatrix, projMatR);
 			Array2Matrix(settings.leftCameraMatrix, camMatL);
 			Array2Matrix(settings.rightCameraMatrix, camMatR);
+
+			auto scheduler = UpdateScheduler::GetInstance();
+			if (scheduler != nullptr)
+			{
+				scheduler->NotifyCamera(renderId);
+			}
 		}
 	}
 
@@ -471,7 +627,7 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetTextureLoader(g_graphics->Create(load, unload));
+		g_EffekseerManager->SetTextureLoader(CreateAsyncLoader(g_graphics->Create(load, unload)));
 	}
 
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetModelLoaderEvent(
@@ -488,7 +644,7 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetModelLoader(g_graphics->Create(load, unload));
+		g_EffekseerManager->SetModelLoader(CreateAsyncLoader(g_graphics->Create(load, unload)));
 	}
 
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetMaterialLoaderEvent(MaterialLoaderLoad load, MaterialLoaderUnload unload)
@@ -503,7 +659,18 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetMaterialLoader(g_graphics->Create(load, unload));
+		g_EffekseerManager->SetMaterialLoader(CreateAsyncLoader(g_graphics->Create(load, unload)));
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetModelLoaderBorrowEvent(ModelLoaderBorrow borrow, BorrowedDataGiveBack giveBack)
+	{
+		EffekseerPlugin::ModelLoader::SetBorrowEvent(borrow, giveBack);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetMaterialLoaderBorrowEvent(MaterialLoaderBorrow borrow,
+																						   BorrowedDataGiveBack giveBack)
+	{
+		EffekseerPlugin::MaterialLoader::SetBorrowEvent(borrow, giveBack);
 	}
 
 
@@ -515,7 +682,7 @@ extern "C"
 			return;
 		}
 
-		g_EffekseerManager->SetSoundLoader(EffekseerPlugin::SoundLoader::Create(load, unload));
+		g_EffekseerManager->SetSoundLoader(CreateAsyncLoader(EffekseerPlugin::SoundLoader::Create(load, unload)));
 	}
 
 	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetSoundPlayerEvent(
@@ -0,0 +1,156 @@
+#include "EffekseerPluginCompression.h"
+#include <string.h>
+
+namespace EffekseerPlugin
+{
+namespace Compression
+{
+
+namespace
+{
+
+bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+{
+	uint8_t b = 0;
+	do
+	{
+		if (ip >= iend)
+		{
+			return false;
+		}
+		b = *ip++;
+		length += b;
+	} while (b == 255);
+	return true;
+}
+
+//! decode sequences of a LZ4 block directly into dst
+bool DecompressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	auto ip = src;
+	auto iend = src + srcSize;
+	auto op = dst;
+	auto oend = dst + dstSize;
+
+	while (ip < iend)
+	{
+		const uint8_t token = *ip++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(ip, iend, literalLength))
+		{
+			return false;
+		}
+
+		if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op))
+		{
+			return false;
+		}
+
+		memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		// the last sequence has only literals
+		if (ip == iend)
+		{
+			break;
+		}
+
+		if (iend - ip < 2)
+		{
+			return false;
+		}
+
+		const size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if (offset == 0 || offset > static_cast<size_t>(op - dst))
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(ip, iend, matchLength))
+		{
+			return false;
+		}
+		matchLength += 4;
+
+		if (matchLength > static_cast<size_t>(oend - op))
+		{
+			return false;
+		}
+
+		const uint8_t* match = op - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(op, match, matchLength);
+		}
+		else
+		{
+			// a match overlaps with itself to repeat a pattern
+			for (size_t i = 0; i < matchLength; i++)
+			{
+				op[i] = match[i];
+			}
+		}
+		op += matchLength;
+	}
+
+	return op == oend;
+}
+
+} // namespace
+
+bool IsCompressed(const void* data, size_t size)
+{
+	return data != nullptr && size >= sizeof(Header) && memcmp(data, Magic, sizeof(Magic)) == 0;
+}
+
+size_t GetDecompressedSize(const void* data, size_t size)
+{
+	if (!IsCompressed(data, size))
+	{
+		return 0;
+	}
+
+	Header header;
+	memcpy(&header, data, sizeof(Header));
+
+	const auto compressedSize = static_cast<uint64_t>(size - sizeof(Header));
+	if (header.RawSize > MaxRawSize || header.RawSize > compressedSize * MaxRatio || header.RawSize > SIZE_MAX)
+	{
+		return 0;
+	}
+	return static_cast<size_t>(header.RawSize);
+}
+
+bool Decompress(const void* data, size_t size, void* dst, size_t dstSize)
+{
+	if (!IsCompressed(data, size))
+	{
+		return false;
+	}
+
+	Header header;
+	memcpy(&header, data, sizeof(Header));
+	if (header.RawSize != dstSize)
+	{
+		return false;
+	}
+
+	auto src = static_cast<const uint8_t*>(data) + sizeof(Header);
+	auto srcSize = size - sizeof(Header);
+
+	switch (header.Method)
+	{
+	case Codec::LZ4:
+		return DecompressLZ4(src, srcSize, static_cast<uint8_t*>(dst), dstSize);
+	default:
+		return false;
+	}
+}
+
+} // namespace Compression
+} // namespace EffekseerPlugin
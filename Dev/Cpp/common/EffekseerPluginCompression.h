@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a container of compressed data which loaders decompress transparently
+	@note
+	A container consists of a header and a compressed block. Values are little endian.
+	LZ4 blocks are compatible with LZ4_compress_default of the reference implementation.
+	It is shared with the bundle builder, so it must not depend on Effekseer.
+*/
+namespace Compression
+{
+
+const uint8_t Magic[4] = {'E', 'F', 'K', 'Z'};
+
+enum class Codec : uint32_t
+{
+	LZ4 = 1,
+};
+
+struct Header
+{
+	uint8_t Magic[4];
+	Codec Method;
+	//! a size of decompressed data
+	uint64_t RawSize;
+};
+
+static_assert(sizeof(Header) == 16, "a header must not be padded");
+
+//! whether data starts with a header of a container
+bool IsCompressed(const void* data, size_t size);
+
+//! an LZ4 block never expands data more than this ratio
+const uint64_t MaxRatio = 255;
+
+//! a limit of decompressed data which rejects broken headers before they are allocated
+const uint64_t MaxRawSize = 1ull << 30;
+
+//! return 0 if data is not a container or a size in a header is impossible
+size_t GetDecompressedSize(const void* data, size_t size);
+
+/**
+	@brief	decompress a container into dst which has GetDecompressedSize bytes
+	@return	false if a container is broken or a codec is not supported
+*/
+bool Decompress(const void* data, size_t size, void* dst, size_t dstSize);
+
+} // namespace Compression
+
+} // namespace EffekseerPlugin
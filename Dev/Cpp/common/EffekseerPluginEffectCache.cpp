@@ -0,0 +1,88 @@
+#include "EffekseerPluginEffectCache.h"
+#include "EffekseerPluginHash.h"
+
+namespace EffekseerPlugin
+{
+
+std::shared_ptr<EffectCache> EffectCache::instance_;
+
+void EffectCache::Initialize() { instance_ = std::make_shared<EffectCache>(); }
+
+void EffectCache::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<EffectCache> EffectCache::GetInstance() { return instance_; }
+
+EffectCache::Key EffectCache::CreateKey(const void* data, int32_t size, float magnification)
+{
+	Key key;
+	key.Hash = HashContent(data, static_cast<size_t>(size));
+	key.Size = static_cast<uint64_t>(size);
+	key.Magnification = magnification;
+	return key;
+}
+
+Effekseer::Effect* EffectCache::Find(const Key& key)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = entries_.find(key);
+	if (it == entries_.end())
+	{
+		return nullptr;
+	}
+
+	it->second.LoadCount++;
+	it->second.Effect->AddRef();
+	return it->second.Effect;
+}
+
+Effekseer::Effect* EffectCache::Add(const Key& key, Effekseer::Effect* effect)
+{
+	if (effect == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = entries_.find(key);
+	if (it != entries_.end())
+	{
+		// another load created the same effect while this effect was created
+		it->second.LoadCount++;
+		it->second.Effect->AddRef();
+		effect->Release();
+		return it->second.Effect;
+	}
+
+	Entry entry;
+	entry.Effect = effect;
+	entry.LoadCount = 1;
+	entries_[key] = entry;
+	keys_[effect] = key;
+	return effect;
+}
+
+int32_t EffectCache::Release(Effekseer::Effect* effect)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto keyIt = keys_.find(effect);
+	if (keyIt == keys_.end())
+	{
+		return 0;
+	}
+
+	auto it = entries_.find(keyIt->second);
+	it->second.LoadCount--;
+
+	const auto loadCount = it->second.LoadCount;
+	if (loadCount <= 0)
+	{
+		entries_.erase(it);
+		keys_.erase(keyIt);
+	}
+	return loadCount;
+}
+
+} // namespace EffekseerPlugin
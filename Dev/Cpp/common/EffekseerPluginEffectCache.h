@@ -0,0 +1,83 @@
+#pragma once
+
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	effects which are loaded from memory, keyed by hashes of contents and magnifications
+	@note
+	A load of the same data shares an effect instead of creating it again.
+	The cache does not own effects. An entry is removed when all of loads which share it are released.
+*/
+class EffectCache
+{
+public:
+	struct Key
+	{
+		uint64_t Hash = 0;
+		uint64_t Size = 0;
+		float Magnification = 0.0f;
+
+		bool operator==(const Key& other) const
+		{
+			return Hash == other.Hash && Size == other.Size && Magnification == other.Magnification;
+		}
+	};
+
+	struct KeyHasher
+	{
+		size_t operator()(const Key& key) const { return static_cast<size_t>(key.Hash); }
+	};
+
+private:
+	struct Entry
+	{
+		Effekseer::Effect* Effect = nullptr;
+		int32_t LoadCount = 0;
+	};
+
+	std::mutex mtx_;
+	std::unordered_map<Key, Entry, KeyHasher> entries_;
+	std::unordered_map<Effekseer::Effect*, Key> keys_;
+
+	static std::shared_ptr<EffectCache> instance_;
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<EffectCache> GetInstance();
+
+	//! hash data once and use it for Find and Add
+	static Key CreateKey(const void* data, int32_t size, float magnification);
+
+	//! return a loaded effect with AddRef or null
+	Effekseer::Effect* Find(const Key& key);
+
+	/**
+		@brief	register a created effect
+		@return	an effect which should be used. It is different from effect if another load registered it first.
+	*/
+	Effekseer::Effect* Add(const Key& key, Effekseer::Effect* effect);
+
+	/**
+		@brief	notify that a load of an effect is released
+		@return	the number of loads which still share it
+	*/
+	int32_t Release(Effekseer::Effect* effect);
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,304 @@
+#include "EffekseerPluginGroup.h"
+#include "EffekseerPluginScheduler.h"
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginMaterial.h"
+#include <vector>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+std::shared_ptr<EffectGroups> EffectGroups::instance_;
+
+void EffectGroups::Initialize() { instance_ = std::make_shared<EffectGroups>(); }
+
+void EffectGroups::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<EffectGroups> EffectGroups::GetInstance() { return instance_; }
+
+void EffectGroups::RemoveWithoutLock(int32_t handle)
+{
+	auto it = handle2group_.find(handle);
+	if (it == handle2group_.end())
+	{
+		return;
+	}
+
+	auto git = groups_.find(it->second);
+	if (git != groups_.end())
+	{
+		git->second.erase(handle);
+		if (git->second.empty())
+		{
+			groups_.erase(git);
+		}
+	}
+
+	handle2group_.erase(it);
+}
+
+void EffectGroups::SetGroup(int32_t handle, int32_t group)
+{
+	if (handle < 0)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	RemoveWithoutLock(handle);
+
+	if (group < 0)
+	{
+		return;
+	}
+
+	groups_[group].insert(handle);
+	handle2group_[handle] = group;
+}
+
+int32_t EffectGroups::GetGroup(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handle2group_.find(handle);
+	if (it == handle2group_.end())
+	{
+		return -1;
+	}
+	return it->second;
+}
+
+int32_t EffectGroups::GetCount(int32_t group)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = groups_.find(group);
+	if (it == groups_.end())
+	{
+		return 0;
+	}
+	return static_cast<int32_t>(it->second.size());
+}
+
+void EffectGroups::SetPaused(int32_t group, bool paused)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	states_[group].Paused = paused;
+}
+
+void EffectGroups::SetSpeed(int32_t group, float speed)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	states_[group].Speed = speed;
+}
+
+void EffectGroups::SetShown(int32_t group, bool shown)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	states_[group].Shown = shown;
+}
+
+EffectGroups::State EffectGroups::GetState(int32_t group)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = states_.find(group);
+	if (it == states_.end())
+	{
+		return State();
+	}
+	return it->second;
+}
+
+void EffectGroups::ForEach(Effekseer::Manager* manager, int32_t group, const std::function<void(int32_t)>& func)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = groups_.find(group);
+	if (it == groups_.end())
+	{
+		return;
+	}
+
+	std::vector<int32_t> removed;
+
+	for (auto handle : it->second)
+	{
+		if (manager->Exists(handle))
+		{
+			func(handle);
+		}
+		else
+		{
+			removed.push_back(handle);
+		}
+	}
+
+	for (auto handle : removed)
+	{
+		RemoveWithoutLock(handle);
+	}
+}
+
+void EffectGroups::Sweep(Effekseer::Manager* manager)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::vector<int32_t> removed;
+
+	for (const auto& pair : handle2group_)
+	{
+		if (!manager->Exists(pair.first))
+		{
+			removed.push_back(pair.first);
+		}
+	}
+
+	for (auto handle : removed)
+	{
+		RemoveWithoutLock(handle);
+	}
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+namespace
+{
+
+//! apply values of a group which differ from defaults, so values of a handle itself are kept otherwise
+void ApplyGroupState(EffectGroups* groups, int32_t handle, int32_t group)
+{
+	if (handle < 0 || group < 0)
+	{
+		return;
+	}
+
+	const auto state = groups->GetState(group);
+	const EffectGroups::State defaultState;
+
+	if (state.Paused != defaultState.Paused)
+	{
+		g_EffekseerManager->SetPaused(handle, state.Paused);
+	}
+
+	if (state.Speed != defaultState.Speed)
+	{
+		UpdateScheduler::SetSpeed(g_EffekseerManager, handle, state.Speed);
+	}
+
+	if (state.Shown != defaultState.Shown)
+	{
+		MaterialEvent::SetShown(g_EffekseerManager, handle, state.Shown);
+	}
+}
+
+} // namespace
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerPlayEffectWithGroup(Effekseer::Effect* effect, float x, float y, float z, int group)
+	{
+		if (g_EffekseerManager == nullptr || effect == nullptr)
+		{
+			return -1;
+		}
+
+		auto handle = InstanceBudget::Play(g_EffekseerManager, effect, Effekseer::Vector3D(x, y, z));
+		MaterialEvent::OnPlayed(g_EffekseerManager, effect, handle);
+
+		auto groups = EffectGroups::GetInstance();
+		if (handle >= 0 && groups != nullptr)
+		{
+			groups->SetGroup(handle, group);
+			ApplyGroupState(groups.get(), handle, group);
+		}
+
+		return handle;
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetGroup(int handle, int group)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (groups != nullptr)
+		{
+			groups->SetGroup(handle, group);
+
+			if (g_EffekseerManager != nullptr && g_EffekseerManager->Exists(handle))
+			{
+				ApplyGroupState(groups.get(), handle, group);
+			}
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetGroup(int handle)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (groups == nullptr)
+		{
+			return -1;
+		}
+
+		return groups->GetGroup(handle);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetGroupCount(int group)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (groups == nullptr)
+		{
+			return 0;
+		}
+
+		return groups->GetCount(group);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerStopGroup(int group)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (g_EffekseerManager == nullptr || groups == nullptr)
+		{
+			return;
+		}
+
+		groups->ForEach(g_EffekseerManager, group, [](int32_t handle) { g_EffekseerManager->StopEffect(handle); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetPausedToGroup(int group, int paused)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (g_EffekseerManager == nullptr || groups == nullptr)
+		{
+			return;
+		}
+
+		groups->SetPaused(group, paused != 0);
+		groups->ForEach(g_EffekseerManager, group, [paused](int32_t handle) { g_EffekseerManager->SetPaused(handle, paused != 0); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetShownToGroup(int group, int shown)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (g_EffekseerManager == nullptr || groups == nullptr)
+		{
+			return;
+		}
+
+		groups->SetShown(group, shown != 0);
+		groups->ForEach(g_EffekseerManager, group, [shown](int32_t handle) { MaterialEvent::SetShown(g_EffekseerManager, handle, shown != 0); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetSpeedToGroup(int group, float speed)
+	{
+		auto groups = EffectGroups::GetInstance();
+		if (g_EffekseerManager == nullptr || groups == nullptr)
+		{
+			return;
+		}
+
+		groups->SetSpeed(group, speed);
+		groups->ForEach(g_EffekseerManager, group, [speed](int32_t handle) { UpdateScheduler::SetSpeed(g_EffekseerManager, handle, speed); });
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	groups of handles which are paused, stopped or hidden together
+	@note
+	A handle belongs to one group at most. Removed handles are dropped when Sweep is called.
+	A group remembers whether it is paused, its speed and its visibility even if it has no handles,
+	so they are applied to handles which join it later.
+*/
+class EffectGroups
+{
+public:
+	struct State
+	{
+		bool Paused = false;
+		float Speed = 1.0f;
+		bool Shown = true;
+	};
+
+private:
+	std::mutex mtx_;
+	std::unordered_map<int32_t, std::unordered_set<int32_t>> groups_;
+	std::unordered_map<int32_t, int32_t> handle2group_;
+	std::unordered_map<int32_t, State> states_;
+
+	static std::shared_ptr<EffectGroups> instance_;
+
+	void RemoveWithoutLock(int32_t handle);
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<EffectGroups> GetInstance();
+
+	//! assign a handle to a group. if group is negative, the handle is removed from its group
+	void SetGroup(int32_t handle, int32_t group);
+
+	int32_t GetGroup(int32_t handle);
+
+	int32_t GetCount(int32_t group);
+
+	//! store values which are applied to handles which join a group
+	void SetPaused(int32_t group, bool paused);
+
+	void SetSpeed(int32_t group, float speed);
+
+	void SetShown(int32_t group, bool shown);
+
+	State GetState(int32_t group);
+
+	//! call a function with each living handle in a group
+	void ForEach(Effekseer::Manager* manager, int32_t group, const std::function<void(int32_t)>& func);
+
+	//! drop handles which have been removed from a manager
+	void Sweep(Effekseer::Manager* manager);
+};
+
+} // namespace EffekseerPlugin
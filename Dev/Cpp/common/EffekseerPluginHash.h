@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a 64-bit hash of contents (XXH64)
+	@note
+	It is fast enough to hash whole files before they are parsed.
+*/
+uint64_t HashContent(const void* data, size_t size, uint64_t seed = 0);
+
+} // namespace EffekseerPlugin
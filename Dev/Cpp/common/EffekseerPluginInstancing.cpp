@@ -0,0 +1,274 @@
+#include "EffekseerPluginInstancing.h"
+#include "../graphicsAPI/EffekseerPluginGraphics.h"
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginMaterial.h"
+#include <algorithm>
+#include <cmath>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+extern Graphics* g_graphics;
+
+namespace
+{
+Effekseer::Matrix44 ToMatrix44(const Effekseer::Matrix43& mat)
+{
+	Effekseer::Matrix44 ret;
+	for (int32_t r = 0; r < 4; r++)
+	{
+		for (int32_t c = 0; c < 3; c++)
+		{
+			ret.Values[r][c] = mat.Value[r][c];
+		}
+		ret.Values[r][3] = r == 3 ? 1.0f : 0.0f;
+	}
+	return ret;
+}
+} // namespace
+
+std::shared_ptr<InstancedEffects> InstancedEffects::instance_;
+
+void InstancedEffects::Initialize() { instance_ = std::make_shared<InstancedEffects>(); }
+
+void InstancedEffects::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<InstancedEffects> InstancedEffects::GetInstance() { return instance_; }
+
+InstancedEffects::~InstancedEffects()
+{
+	for (auto& pair : effects_)
+	{
+		ES_SAFE_RELEASE(pair.second.Effect);
+	}
+}
+
+int32_t InstancedEffects::Create(Effekseer::Manager* manager, Effekseer::Effect* effect, int32_t bucketCount, float phaseFrames)
+{
+	bucketCount = std::max(1, bucketCount);
+	phaseFrames = std::max(0.0f, phaseFrames);
+
+	InstancedEffect instanced;
+	instanced.PhaseFrames = phaseFrames;
+	instanced.Transforms.resize(bucketCount);
+
+	for (int32_t b = 0; b < bucketCount; b++)
+	{
+		auto startFrame = static_cast<int32_t>(phaseFrames * b / bucketCount);
+		auto handle = InstanceBudget::Play(manager, effect, Effekseer::Vector3D(), startFrame);
+		MaterialEvent::OnPlayed(manager, effect, handle);
+
+		// handles are drawn only with transforms of instances
+		if (handle >= 0)
+		{
+			manager->SetAutoDrawing(handle, false);
+		}
+		instanced.Handles.push_back(handle);
+	}
+
+	instanced.Effect = effect;
+	ES_SAFE_ADDREF(instanced.Effect);
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	auto id = nextId_++;
+	effects_[id] = instanced;
+	return id;
+}
+
+void InstancedEffects::Destroy(Effekseer::Manager* manager, int32_t id)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = effects_.find(id);
+	if (it == effects_.end())
+	{
+		return;
+	}
+
+	for (auto handle : it->second.Handles)
+	{
+		if (handle >= 0)
+		{
+			manager->StopEffect(handle);
+		}
+	}
+
+	ES_SAFE_RELEASE(it->second.Effect);
+	effects_.erase(it);
+}
+
+void InstancedEffects::SetTransforms(int32_t id, const float* matrices, const float* timeOffsets, int32_t count)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = effects_.find(id);
+	if (it == effects_.end())
+	{
+		return;
+	}
+
+	auto& instanced = it->second;
+	const auto bucketCount = static_cast<int32_t>(instanced.Transforms.size());
+
+	for (auto& transforms : instanced.Transforms)
+	{
+		transforms.clear();
+	}
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		Effekseer::Matrix43 mat;
+		memcpy(mat.Value, matrices + i * 12, sizeof(float) * 12);
+
+		int32_t bucket = 0;
+		if (timeOffsets != nullptr && instanced.PhaseFrames > 0.0f)
+		{
+			auto phase = std::fmod(timeOffsets[i], instanced.PhaseFrames);
+			if (phase < 0.0f)
+			{
+				phase += instanced.PhaseFrames;
+			}
+			bucket = std::min(bucketCount - 1, static_cast<int32_t>(phase / instanced.PhaseFrames * bucketCount));
+		}
+
+		instanced.Transforms[bucket].push_back(ToMatrix44(mat));
+	}
+}
+
+Effekseer::Handle InstancedEffects::GetHandle(int32_t id, int32_t bucket)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = effects_.find(id);
+	if (it == effects_.end() || bucket < 0 || bucket >= static_cast<int32_t>(it->second.Handles.size()))
+	{
+		return -1;
+	}
+	return it->second.Handles[bucket];
+}
+
+void InstancedEffects::Draw(Effekseer::Manager* manager,
+							Graphics* graphics,
+							EffekseerRenderer::Renderer* renderer,
+							const Effekseer::Manager::DrawParameter& drawParameter,
+							InstancedDrawPass pass)
+{
+	auto instancedEffects = GetInstance();
+	if (instancedEffects == nullptr || !graphics->IsInstancedDrawingSupported())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(instancedEffects->mtx_);
+
+	std::vector<Effekseer::Matrix44> transforms;
+	auto materialEvent = MaterialEvent::GetInstance();
+
+	for (const auto& pair : instancedEffects->effects_)
+	{
+		const auto& instanced = pair.second;
+
+		// handles are drawn directly, so materials which wait for loading must be skipped here
+		if (materialEvent != nullptr && materialEvent->HasPendingMaterials(instanced.Effect))
+		{
+			continue;
+		}
+
+		for (size_t b = 0; b < instanced.Handles.size(); b++)
+		{
+			auto handle = instanced.Handles[b];
+			if (handle < 0 || instanced.Transforms[b].empty() || !manager->Exists(handle))
+			{
+				continue;
+			}
+
+			// transforms of instances replace a transform of the handle
+			const auto handleMatrix = ToMatrix44(manager->GetMatrix(handle));
+			const Effekseer::Vector3D origin(handleMatrix.Values[3][0], handleMatrix.Values[3][1], handleMatrix.Values[3][2]);
+			Effekseer::Matrix44 inv;
+			Effekseer::Matrix44::Inverse(inv, handleMatrix);
+
+			transforms.resize(instanced.Transforms[b].size());
+			for (size_t i = 0; i < transforms.size(); i++)
+			{
+				Effekseer::Matrix44::Mul(transforms[i], inv, instanced.Transforms[b][i]);
+			}
+
+			auto marker = graphics->BeginInstancedDrawing(renderer);
+
+			if (pass == InstancedDrawPass::Back)
+			{
+				manager->DrawHandleBack(handle, drawParameter);
+			}
+			else if (pass == InstancedDrawPass::Front)
+			{
+				manager->DrawHandleFront(handle, drawParameter);
+			}
+			else
+			{
+				manager->DrawHandle(handle, drawParameter);
+			}
+
+			graphics->EndInstancedDrawing(renderer, marker, transforms, origin);
+		}
+	}
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerCreateInstancedEffect(Effekseer::Effect* effect, int bucketCount, float phaseFrames)
+	{
+		auto instanced = InstancedEffects::GetInstance();
+		if (g_EffekseerManager == nullptr || g_graphics == nullptr || instanced == nullptr || effect == nullptr)
+		{
+			return -1;
+		}
+
+		if (!g_graphics->IsInstancedDrawingSupported())
+		{
+			return -1;
+		}
+
+		return instanced->Create(g_EffekseerManager, effect, bucketCount, phaseFrames);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerDestroyInstancedEffect(int id)
+	{
+		auto instanced = InstancedEffects::GetInstance();
+		if (g_EffekseerManager == nullptr || instanced == nullptr)
+		{
+			return;
+		}
+
+		instanced->Destroy(g_EffekseerManager, id);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetInstancedTransforms(int id,
+																					  const float* matrices,
+																					  const float* timeOffsets,
+																					  int count)
+	{
+		auto instanced = InstancedEffects::GetInstance();
+		if (instanced == nullptr || (matrices == nullptr && count > 0))
+		{
+			return;
+		}
+
+		instanced->SetTransforms(id, matrices, timeOffsets, count);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetInstancedEffectHandle(int id, int bucket)
+	{
+		auto instanced = InstancedEffects::GetInstance();
+		if (instanced == nullptr)
+		{
+			return -1;
+		}
+
+		return instanced->GetHandle(id, bucket);
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerRenderer
+{
+class Renderer;
+}
+
+namespace EffekseerPlugin
+{
+class Graphics;
+
+enum class InstancedDrawPass
+{
+	All,
+	Back,
+	Front,
+};
+
+/**
+	@brief	identical effects which share simulations and differ only by transforms
+	@note
+	An instanced effect plays one hidden handle for each phase bucket and the handles are started with different frames.
+	Geometry of a handle is drawn once and duplicated for each transform of its bucket by a graphics.
+	It is available only when a graphics supports instanced drawing.
+	Models are transformed entirely. Geometry which is built such as sprites and ribbons is only translated and scaled
+	because billboards must keep facing the camera and they are not distinguished from fixed ones in exported data.
+*/
+class InstancedEffects
+{
+private:
+	struct InstancedEffect
+	{
+		Effekseer::Effect* Effect = nullptr;
+		float PhaseFrames = 0.0f;
+		std::vector<Effekseer::Handle> Handles;
+		std::vector<std::vector<Effekseer::Matrix44>> Transforms;
+	};
+
+	std::mutex mtx_;
+	int32_t nextId_ = 0;
+	std::unordered_map<int32_t, InstancedEffect> effects_;
+
+	static std::shared_ptr<InstancedEffects> instance_;
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<InstancedEffects> GetInstance();
+
+	~InstancedEffects();
+
+	//! return an id or -1
+	int32_t Create(Effekseer::Manager* manager, Effekseer::Effect* effect, int32_t bucketCount, float phaseFrames);
+
+	void Destroy(Effekseer::Manager* manager, int32_t id);
+
+	/**
+		@brief	set transforms of instances
+		@param	matrices	Matrix43 values of instances
+		@param	timeOffsets	time offsets of instances in frames which are quantized to buckets. nullptr means the first bucket
+	*/
+	void SetTransforms(int32_t id, const float* matrices, const float* timeOffsets, int32_t count);
+
+	Effekseer::Handle GetHandle(int32_t id, int32_t bucket);
+
+	//! draw instances after a manager draws other handles if it is initialized
+	static void Draw(Effekseer::Manager* manager,
+					 Graphics* graphics,
+					 EffekseerRenderer::Renderer* renderer,
+					 const Effekseer::Manager::DrawParameter& drawParameter,
+					 InstancedDrawPass pass);
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,285 @@
+#include "EffekseerPluginManagers.h"
+#include "EffekseerPluginMaterial.h"
+#include <EffekseerRenderer.Renderer.h>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+extern EffekseerRenderer::Renderer* g_EffekseerRenderer;
+
+std::shared_ptr<EffectManagers> EffectManagers::instance_;
+
+EffectManagers::ManagerState::~ManagerState()
+{
+	if (Manager != nullptr)
+	{
+		MaterialEvent::RemoveManager(Manager);
+		Manager->Destroy();
+		Manager = nullptr;
+	}
+}
+
+void EffectManagers::Initialize() { instance_ = std::make_shared<EffectManagers>(); }
+
+void EffectManagers::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<EffectManagers> EffectManagers::GetInstance() { return instance_; }
+
+void EffectManagers::AttachRenderer(Effekseer::Manager* manager, EffekseerRenderer::Renderer* renderer)
+{
+	manager->SetSpriteRenderer(renderer->CreateSpriteRenderer());
+	manager->SetRibbonRenderer(renderer->CreateRibbonRenderer());
+	manager->SetRingRenderer(renderer->CreateRingRenderer());
+	manager->SetTrackRenderer(renderer->CreateTrackRenderer());
+	manager->SetModelRenderer(renderer->CreateModelRenderer());
+}
+
+std::vector<std::shared_ptr<EffectManagers::ManagerState>> EffectManagers::GetManagers()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::vector<std::shared_ptr<ManagerState>> managers;
+	managers.reserve(managers_.size());
+	for (const auto& pair : managers_)
+	{
+		managers.push_back(pair.second);
+	}
+	return managers;
+}
+
+int32_t EffectManagers::Create(Effekseer::Manager* defaultManager, EffekseerRenderer::Renderer* renderer, int32_t maxInstances)
+{
+	auto manager = Effekseer::Manager::Create(maxInstances);
+	if (manager == nullptr)
+	{
+		return -1;
+	}
+
+	// loaders and a coordinate system are shared
+	manager->SetSetting(defaultManager->GetSetting());
+
+	if (renderer != nullptr)
+	{
+		AttachRenderer(manager, renderer);
+	}
+
+	auto state = std::make_shared<ManagerState>();
+	state->Manager = manager;
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	auto id = nextId_++;
+	managers_[id] = state;
+	return id;
+}
+
+void EffectManagers::Destroy(int32_t id)
+{
+	std::shared_ptr<ManagerState> state;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		auto it = managers_.find(id);
+		if (it == managers_.end())
+		{
+			return;
+		}
+		state = it->second;
+		managers_.erase(it);
+	}
+
+	// wait for an update or drawing of the manager
+	std::lock_guard<std::mutex> lock(state->Mutex);
+	MaterialEvent::RemoveManager(state->Manager);
+	state->Manager->Destroy();
+	state->Manager = nullptr;
+}
+
+std::shared_ptr<EffectManagers::ManagerState> EffectManagers::Get(int32_t id)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = managers_.find(id);
+	if (it == managers_.end())
+	{
+		return nullptr;
+	}
+	return it->second;
+}
+
+void EffectManagers::SetRenderer(EffekseerRenderer::Renderer* renderer)
+{
+	for (const auto& state : GetManagers())
+	{
+		std::lock_guard<std::mutex> lock(state->Mutex);
+		if (state->Manager != nullptr)
+		{
+			AttachRenderer(state->Manager, renderer);
+		}
+	}
+}
+
+void EffectManagers::Draw(const Effekseer::Manager::DrawParameter& drawParameter, InstancedDrawPass pass)
+{
+	auto managers = GetInstance();
+	if (managers == nullptr)
+	{
+		return;
+	}
+
+	for (const auto& state : managers->GetManagers())
+	{
+		std::lock_guard<std::mutex> lock(state->Mutex);
+		if (state->Manager == nullptr || !state->IsRendered)
+		{
+			continue;
+		}
+
+		if (pass == InstancedDrawPass::Back)
+		{
+			state->Manager->DrawBack(drawParameter);
+		}
+		else if (pass == InstancedDrawPass::Front)
+		{
+			state->Manager->DrawFront(drawParameter);
+		}
+		else
+		{
+			state->Manager->Draw(drawParameter);
+		}
+	}
+}
+
+namespace
+{
+
+//! call f with a state of a manager while it is locked if the manager exists
+template <class F> void WithManager(int32_t id, F f)
+{
+	auto managers = EffectManagers::GetInstance();
+	auto state = managers != nullptr ? managers->Get(id) : nullptr;
+	if (state == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(state->Mutex);
+	if (state->Manager != nullptr)
+	{
+		f(*state);
+	}
+}
+
+} // namespace
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerCreateManager(int maxInstances)
+	{
+		auto managers = EffectManagers::GetInstance();
+		if (g_EffekseerManager == nullptr || managers == nullptr)
+		{
+			return -1;
+		}
+
+		return managers->Create(g_EffekseerManager, g_EffekseerRenderer, maxInstances);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerDestroyManager(int id)
+	{
+		auto managers = EffectManagers::GetInstance();
+		if (managers == nullptr)
+		{
+			return;
+		}
+
+		managers->Destroy(id);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerUpdate(int id, float deltaFrame)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) {
+			state.Manager->Update(deltaFrame);
+			MaterialEvent::ShowLoadedHandles(state.Manager);
+		});
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetRendered(int id, int rendered)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.IsRendered = rendered != 0; });
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerManagerPlayEffect(int id, Effekseer::Effect* effect, float x, float y, float z)
+	{
+		if (effect == nullptr)
+		{
+			return -1;
+		}
+
+		Effekseer::Handle handle = -1;
+		WithManager(id, [&](EffectManagers::ManagerState& state) {
+			handle = state.Manager->Play(effect, x, y, z);
+			MaterialEvent::OnPlayed(state.Manager, effect, handle);
+		});
+		return handle;
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerStopEffect(int id, int handle)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->StopEffect(handle); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerStopAllEffects(int id)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->StopAllEffects(); });
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerManagerExists(int id, int handle)
+	{
+		bool exists = false;
+		WithManager(id, [&](EffectManagers::ManagerState& state) { exists = state.Manager->Exists(handle); });
+		return exists ? 1 : 0;
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetLocation(int id, int handle, float x, float y, float z)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->SetLocation(handle, x, y, z); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetRotation(int id, int handle, float x, float y, float z, float angle)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) {
+			state.Manager->SetRotation(handle, Effekseer::Vector3D(x, y, z), angle);
+		});
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetScale(int id, int handle, float x, float y, float z)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->SetScale(handle, x, y, z); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetShown(int id, int handle, int shown)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { MaterialEvent::SetShown(state.Manager, handle, shown != 0); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetPaused(int id, int handle, int paused)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->SetPaused(handle, paused != 0); });
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerManagerSetSpeed(int id, int handle, float speed)
+	{
+		WithManager(id, [&](EffectManagers::ManagerState& state) { state.Manager->SetSpeed(handle, speed); });
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerManagerGetInstanceCount(int id)
+	{
+		int32_t count = 0;
+		WithManager(id, [&](EffectManagers::ManagerState& state) { count = state.Manager->GetTotalInstanceCount(); });
+		return count;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+#include "EffekseerPluginInstancing.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerRenderer
+{
+class Renderer;
+}
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	managers which are independent from the default manager
+	@note
+	Each manager has its own instance pool and shares a setting and loaders with the default manager.
+	Managers can be updated on different threads because each manager is guarded by its own mutex.
+	Destroying a manager removes all of its effects at once.
+	Sounds are played only by the default manager.
+*/
+class EffectManagers
+{
+public:
+	struct ManagerState
+	{
+		Effekseer::Manager* Manager = nullptr;
+		std::mutex Mutex;
+		bool IsRendered = true;
+
+		~ManagerState();
+	};
+
+private:
+	std::mutex mtx_;
+	int32_t nextId_ = 0;
+	std::unordered_map<int32_t, std::shared_ptr<ManagerState>> managers_;
+
+	static std::shared_ptr<EffectManagers> instance_;
+
+	static void AttachRenderer(Effekseer::Manager* manager, EffekseerRenderer::Renderer* renderer);
+
+	std::vector<std::shared_ptr<ManagerState>> GetManagers();
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<EffectManagers> GetInstance();
+
+	//! return an id or -1
+	int32_t Create(Effekseer::Manager* defaultManager, EffekseerRenderer::Renderer* renderer, int32_t maxInstances);
+
+	void Destroy(int32_t id);
+
+	std::shared_ptr<ManagerState> Get(int32_t id);
+
+	//! set renderers to all managers when a renderer is created
+	void SetRenderer(EffekseerRenderer::Renderer* renderer);
+
+	//! draw managers after the default manager if it is initialized
+	static void Draw(const Effekseer::Manager::DrawParameter& drawParameter, InstancedDrawPass pass);
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,361 @@
+#include "EffekseerPluginMappedFile.h"
+#include "EffekseerPluginNetwork.h"
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#define EFK_PLUGIN_MAPPED_FILE_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EFK_PLUGIN_MAPPED_FILE_POSIX
+#else
+#include <stdio.h>
+#endif
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+namespace
+{
+
+std::string ConvertToUtf8(const char16_t* path)
+{
+	std::string ret;
+
+	for (auto p = path; *p != 0; p++)
+	{
+		uint32_t c = *p;
+
+		// a surrogate pair
+		if (c >= 0xD800 && c <= 0xDBFF && p[1] >= 0xDC00 && p[1] <= 0xDFFF)
+		{
+			c = 0x10000 + ((c - 0xD800) << 10) + (p[1] - 0xDC00);
+			p++;
+		}
+
+		if (c < 0x80)
+		{
+			ret.push_back(static_cast<char>(c));
+		}
+		else if (c < 0x800)
+		{
+			ret.push_back(static_cast<char>(0xC0 | (c >> 6)));
+			ret.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+		}
+		else if (c < 0x10000)
+		{
+			ret.push_back(static_cast<char>(0xE0 | (c >> 12)));
+			ret.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+			ret.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+		}
+		else
+		{
+			ret.push_back(static_cast<char>(0xF0 | (c >> 18)));
+			ret.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+			ret.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+			ret.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+		}
+	}
+
+	return ret;
+}
+
+//! a directory of a path which resources of an effect are loaded from
+std::u16string GetParentDirectory(const char16_t* path)
+{
+	std::u16string ret(path);
+	auto pos = ret.find_last_of(u"/\\");
+	if (pos == std::u16string::npos)
+	{
+		return std::u16string();
+	}
+	return ret.substr(0, pos + 1);
+}
+
+} // namespace
+
+MappedFile::~MappedFile() { Unmap(); }
+
+bool MappedFile::Map(const char16_t* path)
+{
+#if defined(EFK_PLUGIN_MAPPED_FILE_WIN32)
+	file_ = CreateFileW(reinterpret_cast<const wchar_t*>(path),
+						GENERIC_READ,
+						FILE_SHARE_READ,
+						nullptr,
+						OPEN_EXISTING,
+						FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+						nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+	{
+		file_ = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file_, &size) || size.QuadPart <= 0)
+	{
+		return false;
+	}
+
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (mapping_ == nullptr)
+	{
+		return false;
+	}
+
+	data_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0));
+	if (data_ == nullptr)
+	{
+		return false;
+	}
+
+	size_ = static_cast<size_t>(size.QuadPart);
+	return true;
+#elif defined(EFK_PLUGIN_MAPPED_FILE_POSIX)
+	auto fd = open(ConvertToUtf8(path).c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(fd, &status) != 0 || status.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	// a mapping is kept after a descriptor is closed
+	auto data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	data_ = static_cast<uint8_t*>(data);
+	size_ = static_cast<size_t>(status.st_size);
+	return true;
+#else
+	auto fp = fopen(ConvertToUtf8(path).c_str(), "rb");
+	if (fp == nullptr)
+	{
+		return false;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	auto size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	if (size > 0)
+	{
+		buffer_.resize(static_cast<size_t>(size));
+		buffer_.resize(fread(buffer_.data(), 1, buffer_.size(), fp));
+	}
+	fclose(fp);
+
+	if (buffer_.empty())
+	{
+		return false;
+	}
+
+	data_ = buffer_.data();
+	size_ = buffer_.size();
+	return true;
+#endif
+}
+
+void MappedFile::Unmap()
+{
+#if defined(EFK_PLUGIN_MAPPED_FILE_WIN32)
+	if (data_ != nullptr)
+	{
+		UnmapViewOfFile(data_);
+	}
+
+	if (mapping_ != nullptr)
+	{
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+
+	if (file_ != nullptr)
+	{
+		CloseHandle(file_);
+		file_ = nullptr;
+	}
+#elif defined(EFK_PLUGIN_MAPPED_FILE_POSIX)
+	if (data_ != nullptr)
+	{
+		munmap(data_, size_);
+	}
+#else
+	buffer_.clear();
+#endif
+
+	data_ = nullptr;
+	size_ = 0;
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const char16_t* path)
+{
+	if (path == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto file = std::make_shared<MappedFile>();
+	if (!file->Map(path))
+	{
+		return nullptr;
+	}
+	return file;
+}
+
+std::shared_ptr<MappedFiles> MappedFiles::instance_;
+
+void MappedFiles::Initialize() { instance_ = std::make_shared<MappedFiles>(); }
+
+void MappedFiles::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<MappedFiles> MappedFiles::GetInstance() { return instance_; }
+
+std::shared_ptr<MappedFile> MappedFiles::Open(const char16_t* path)
+{
+	if (path == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::u16string key(path);
+	auto it = files_.find(key);
+	if (it != files_.end())
+	{
+		auto file = it->second.lock();
+		if (file != nullptr)
+		{
+			return file;
+		}
+		files_.erase(it);
+	}
+
+	auto file = MappedFile::Open(path);
+	if (file != nullptr)
+	{
+		files_[key] = file;
+	}
+	return file;
+}
+
+size_t MappedFileReader::Read(void* buffer, size_t size)
+{
+	auto length = file_->GetSize();
+	if (static_cast<size_t>(position_) >= length)
+	{
+		return 0;
+	}
+
+	if (size > length - position_)
+	{
+		size = length - position_;
+	}
+
+	memcpy(buffer, file_->GetData() + position_, size);
+	position_ += static_cast<int>(size);
+	return size;
+}
+
+void MappedFileReader::Seek(int position) { position_ = position; }
+
+int MappedFileReader::GetPosition() { return position_; }
+
+size_t MappedFileReader::GetLength() { return file_->GetSize(); }
+
+Effekseer::FileReader* MappedFileInterface::OpenRead(const EFK_CHAR* path)
+{
+	auto files = MappedFiles::GetInstance();
+	auto file = files != nullptr ? files->Open((const char16_t*)path) : MappedFile::Open((const char16_t*)path);
+	if (file == nullptr)
+	{
+		return nullptr;
+	}
+	return new MappedFileReader(file);
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	// use mapped files when effects are loaded from paths
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetFileMappingEnabled(int enabled)
+	{
+		if (g_EffekseerManager == nullptr)
+		{
+			return;
+		}
+
+		auto setting = g_EffekseerManager->GetSetting();
+		if (enabled != 0)
+		{
+			auto files = MappedFiles::GetInstance();
+			if (files == nullptr)
+			{
+				return;
+			}
+			setting->SetEffectLoader(Effekseer::Effect::CreateEffectLoader(files->GetFileInterface()));
+		}
+		else
+		{
+			setting->SetEffectLoader(Effekseer::Effect::CreateEffectLoader());
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT Effekseer::Effect* UNITY_INTERFACE_API EffekseerLoadEffectWithFileMapping(const EFK_CHAR* path,
+																								   float magnification)
+	{
+		auto files = MappedFiles::GetInstance();
+		if (g_EffekseerManager == nullptr || files == nullptr || path == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto file = files->Open((const char16_t*)path);
+		if (file == nullptr)
+		{
+			return nullptr;
+		}
+
+		// resources are loaded relative to an effect like Effect::Create with a path
+		auto parentDirectory = GetParentDirectory((const char16_t*)path);
+		auto effect = Effekseer::Effect::Create(g_EffekseerManager,
+												file->GetData(),
+												static_cast<int32_t>(file->GetSize()),
+												magnification,
+												(const EFK_CHAR*)parentDirectory.c_str());
+		if (effect == nullptr)
+		{
+			return nullptr;
+		}
+
+		effect->SetName(path);
+
+#ifndef _SWITCH
+		if (Network::GetInstance()->IsRunning())
+		{
+			Network::GetInstance()->Register(effect->GetName(), effect);
+		}
+#endif
+
+		return effect;
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a view of a whole file which is mapped into memory
+	@note
+	A view is mapped with copy on write, so a loader can modify it without modifying a file.
+	A file is read into memory on platforms without mmap.
+*/
+class MappedFile
+{
+private:
+	uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	std::vector<uint8_t> buffer_;
+
+#ifdef _WIN32
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#endif
+
+	bool Map(const char16_t* path);
+
+	void Unmap();
+
+public:
+	MappedFile() = default;
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//! return null if a file is not found
+	static std::shared_ptr<MappedFile> Open(const char16_t* path);
+
+	uint8_t* GetData() const { return data_; }
+
+	size_t GetSize() const { return size_; }
+};
+
+class MappedFileReader : public Effekseer::FileReader
+{
+	std::shared_ptr<MappedFile> file_;
+	int position_ = 0;
+
+public:
+	MappedFileReader(const std::shared_ptr<MappedFile>& file) : file_(file) {}
+
+	virtual ~MappedFileReader() = default;
+
+	size_t Read(void* buffer, size_t size) override;
+
+	void Seek(int position) override;
+
+	int GetPosition() override;
+
+	size_t GetLength() override;
+};
+
+/**
+	@brief	a file interface which reads mapped views instead of buffered files
+	@note
+	It is given to a default effect loader, so that loads of effects from paths read mapped files.
+*/
+class MappedFileInterface : public Effekseer::FileInterface
+{
+public:
+	Effekseer::FileReader* OpenRead(const EFK_CHAR* path) override;
+
+	Effekseer::FileWriter* OpenWrite(const EFK_CHAR* path) override { return nullptr; }
+};
+
+/**
+	@brief	mapped files which are shared between loads of the same path
+	@note
+	A file is unmapped when all of readers and loads which use it release it.
+	Effects copy what they need while they are created, so a file is not kept mapped for loaded effects.
+*/
+class MappedFiles
+{
+private:
+	std::mutex mtx_;
+	std::unordered_map<std::u16string, std::weak_ptr<MappedFile>> files_;
+	MappedFileInterface fileInterface_;
+
+	static std::shared_ptr<MappedFiles> instance_;
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<MappedFiles> GetInstance();
+
+	std::shared_ptr<MappedFile> Open(const char16_t* path);
+
+	//! it lives until Terminate, which is called after a manager is destroyed
+	MappedFileInterface* GetFileInterface() { return &fileInterface_; }
+};
+
+} // namespace EffekseerPlugin
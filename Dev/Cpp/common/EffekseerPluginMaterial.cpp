@@ -1,6 +1,8 @@
 ﻿#include "EffekseerPluginMaterial.h"
+#include "EffekseerPluginBundle.h"
 #include <algorithm>
 #include <assert.h>
+#include <chrono>
 
 namespace EffekseerPlugin
 {
@@ -17,25 +19,38 @@ private:
 	Effekseer::CustomVector<uint8_t> compiledData_;
 	std::shared_ptr<MaterialLoaderHolder> internalLoader_ = nullptr;
 
-public:
-	LazyMaterialData(const std::shared_ptr<MaterialLoaderHolder>& loader,
-					 const Effekseer::CustomVector<uint8_t>& data,
-					 int32_t dataSize,
-					 const Effekseer::CustomVector<uint8_t>& compiledData,
-					 int32_t compiledDataSize)
-		: internalLoader_(loader)
+	//! a compressed container is decompressed directly into a storage
+	static void Assign(Effekseer::CustomVector<uint8_t>& dst, const uint8_t* data, int32_t dataSize)
 	{
-		if (dataSize > 0)
+		if (data == nullptr || dataSize <= 0)
+		{
+			return;
+		}
+
+		auto size = static_cast<size_t>(dataSize);
+		if (!DecompressIfCompressed(data, size, dst))
 		{
-			data_.assign(data.begin(), data.begin() + dataSize);	
+			return;
 		}
 
-		if (compiledDataSize > 0)
+		if (data != dst.data())
 		{
-			compiledData_.assign(compiledData.begin(), compiledData.begin() + compiledDataSize);
+			dst.assign(data, data + size);
 		}
 	}
 
+public:
+	LazyMaterialData(const std::shared_ptr<MaterialLoaderHolder>& loader,
+					 const uint8_t* data,
+					 int32_t dataSize,
+					 const uint8_t* compiledData,
+					 int32_t compiledDataSize)
+		: internalLoader_(loader)
+	{
+		Assign(data_, data, dataSize);
+		Assign(compiledData_, compiledData, compiledDataSize);
+	}
+
 	void Load()
 	{
 		if (compiledData_.size() > 0)
@@ -89,7 +104,7 @@ void MaterialEvent::Terminate()
 {
 	if (instance_ != nullptr)
 	{
-		instance_->Execute();
+		instance_->Flush();
 	}
 	instance_ = nullptr;
 }
@@ -99,72 +114,448 @@ std::shared_ptr<MaterialEvent> MaterialEvent::GetInstance() { return instance_;
 void MaterialEvent::Load(LazyMaterialData* data)
 {
 	std::lock_guard<std::mutex> lock(mtx_);
-
-	Command c;
-	c.type = CommandType::Load;
-	c.data = data;
-	commands_.emplace_back(c);
+	loads_.emplace_back(data);
 }
 
 void MaterialEvent::UnloadAndDelete(LazyMaterialData* data)
 {
 	std::lock_guard<std::mutex> lock(mtx_);
+	unloads_.emplace_back(data);
+}
+
+void MaterialEvent::PrioritizeWithoutLock(Effekseer::Effect* effect)
+{
+	if (loads_.empty())
+	{
+		return;
+	}
+
+	auto isUsed = [effect](LazyMaterialData* data) {
+		for (int32_t i = 0; i < effect->GetMaterialCount(); i++)
+		{
+			if (effect->GetMaterial(i) == static_cast<Effekseer::MaterialData*>(data))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
 
-	Command c;
-	c.type = CommandType::UnloadAndDelete;
-	c.data = data;
-	commands_.emplace_back(c);
+	std::stable_partition(loads_.begin(), loads_.end(), isUsed);
 }
 
-void MaterialEvent::Execute()
+bool MaterialEvent::HasPendingMaterialsWithoutLock(Effekseer::Effect* effect) const
+{
+	for (int32_t i = 0; i < effect->GetMaterialCount(); i++)
+	{
+		auto material = effect->GetMaterial(i);
+		if (material == nullptr)
+		{
+			continue;
+		}
+
+		if (material == loading_ || std::find(loads_.begin(), loads_.end(), material) != loads_.end())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+MaterialEvent::PendingHandle* MaterialEvent::FindPendingHandleWithoutLock(Effekseer::Manager* manager, Effekseer::Handle handle)
+{
+	for (auto& pending : pendingHandles_)
+	{
+		if (pending.Manager == manager && pending.Handle == handle)
+		{
+			return &pending;
+		}
+	}
+	return nullptr;
+}
+
+void MaterialEvent::OnPlayed(Effekseer::Manager* manager, Effekseer::Effect* effect, Effekseer::Handle handle)
+{
+	auto instance = GetInstance();
+	if (instance == nullptr || manager == nullptr || effect == nullptr || handle < 0)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(instance->mtx_);
+
+		instance->PrioritizeWithoutLock(effect);
+		if (!instance->HasPendingMaterialsWithoutLock(effect))
+		{
+			return;
+		}
+
+		PendingHandle pending;
+		pending.Manager = manager;
+		pending.Handle = handle;
+		pending.Effect = effect;
+		instance->pendingHandles_.emplace_back(pending);
+	}
+
+	manager->SetShown(handle, false);
+}
+
+void MaterialEvent::SetShown(Effekseer::Manager* manager, Effekseer::Handle handle, bool shown)
 {
+	auto instance = GetInstance();
+	if (instance != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(instance->mtx_);
+		auto pending = instance->FindPendingHandleWithoutLock(manager, handle);
+		if (pending != nullptr)
+		{
+			pending->Shown = shown;
+			return;
+		}
+	}
+
+	manager->SetShown(handle, shown);
+}
+
+bool MaterialEvent::GetShown(Effekseer::Manager* manager, Effekseer::Handle handle)
+{
+	auto instance = GetInstance();
+	if (instance != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(instance->mtx_);
+		auto pending = instance->FindPendingHandleWithoutLock(manager, handle);
+		if (pending != nullptr)
+		{
+			return pending->Shown;
+		}
+	}
+
+	return manager->GetShown(handle);
+}
+
+void MaterialEvent::ShowLoadedHandles(Effekseer::Manager* manager)
+{
+	auto instance = GetInstance();
+	if (instance == nullptr || manager == nullptr)
+	{
+		return;
+	}
+
+	Effekseer::CustomVector<Effekseer::Handle> shownHandles;
+
+	{
+		std::lock_guard<std::mutex> lock(instance->mtx_);
+
+		auto& pendingHandles = instance->pendingHandles_;
+		for (size_t i = 0; i < pendingHandles.size();)
+		{
+			const auto& pending = pendingHandles[i];
+			if (pending.Manager != manager)
+			{
+				i++;
+				continue;
+			}
+
+			// an effect of a removed handle may be released, so it is not touched
+			if (manager->Exists(pending.Handle))
+			{
+				if (instance->HasPendingMaterialsWithoutLock(pending.Effect))
+				{
+					i++;
+					continue;
+				}
+
+				if (pending.Shown)
+				{
+					shownHandles.emplace_back(pending.Handle);
+				}
+			}
+
+			pendingHandles.erase(pendingHandles.begin() + i);
+		}
+	}
+
+	for (auto handle : shownHandles)
+	{
+		manager->SetShown(handle, true);
+	}
+}
+
+void MaterialEvent::RemoveManager(Effekseer::Manager* manager)
+{
+	auto instance = GetInstance();
+	if (instance == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(instance->mtx_);
+
+	auto& pendingHandles = instance->pendingHandles_;
+	pendingHandles.erase(std::remove_if(pendingHandles.begin(),
+										pendingHandles.end(),
+										[manager](const PendingHandle& pending) { return pending.Manager == manager; }),
+						 pendingHandles.end());
+}
+
+bool MaterialEvent::HasPendingMaterials(Effekseer::Effect* effect)
+{
+	if (effect == nullptr)
+	{
+		return false;
+	}
+
 	std::lock_guard<std::mutex> lock(mtx_);
+	return HasPendingMaterialsWithoutLock(effect);
+}
+
+void MaterialEvent::SetBudget(float maxMilliseconds, int32_t maxCount)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	maxMilliseconds_ = maxMilliseconds;
+	maxCount_ = maxCount;
+}
+
+void MaterialEvent::Execute()
+{
+	float maxMilliseconds = 0.0f;
+	int32_t maxCount = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		maxMilliseconds = maxMilliseconds_;
+		maxCount = maxCount_;
+	}
+
+	Execute(maxMilliseconds, maxCount);
+}
+
+void MaterialEvent::Flush() { Execute(0.0f, 0); }
+
+void MaterialEvent::Execute(float maxMilliseconds, int32_t maxCount)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto startTime = Clock::now();
+
+	Effekseer::CustomVector<LazyMaterialData*> unloads;
 
-	for (auto& c : commands_)
 	{
-		if (c.type == CommandType::Load)
+		std::lock_guard<std::mutex> lock(mtx_);
+		unloads.swap(unloads_);
+
+		// a material which is released before it is loaded is not loaded
+		for (auto data : unloads)
 		{
-			c.data->Load();
+			auto it = std::find(loads_.begin(), loads_.end(), data);
+			if (it != loads_.end())
+			{
+				loads_.erase(it);
+			}
 		}
-		else if (c.type == CommandType::UnloadAndDelete)
+	}
+
+	for (auto data : unloads)
+	{
+		data->Unload();
+		ES_SAFE_DELETE(data);
+	}
+
+	// materials are deleted only on this thread, so they can be loaded without a lock
+	for (int32_t count = 0;; count++)
+	{
+		if (count > 0)
 		{
-			c.data->Unload();
-			ES_SAFE_DELETE(c.data);
+			if (maxCount > 0 && count >= maxCount)
+			{
+				break;
+			}
+
+			const auto elapsed = std::chrono::duration<float, std::milli>(Clock::now() - startTime).count();
+			if (maxMilliseconds > 0.0f && elapsed >= maxMilliseconds)
+			{
+				break;
+			}
 		}
-		else
+
+		LazyMaterialData* data = nullptr;
+
 		{
-			assert(0);
+			std::lock_guard<std::mutex> lock(mtx_);
+			if (loads_.empty())
+			{
+				break;
+			}
+
+			// it is still pending until it is loaded, so handles of its effect are not shown meanwhile
+			data = loads_.front();
+			loads_.erase(loads_.begin());
+			loading_ = data;
+		}
+
+		data->Load();
+
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			loading_ = nullptr;
 		}
 	}
+}
 
-	commands_.clear();
+int32_t MaterialEvent::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return static_cast<int32_t>(loads_.size()) + (loading_ != nullptr ? 1 : 0);
 }
 
 MaterialLoader::MaterialLoader(MaterialLoaderLoad load, MaterialLoaderUnload unload)
-	: load_(load), unload_(unload), memoryFile_(1 * 1024 * 1024), memoryFileForCache_(1 * 1024 * 1024)
+	: load_(load), unload_(unload), buffers_(1 * 1024 * 1024)
 {
+	resources.SetReleaseCallback([this](const std::u16string& path, LazyMaterialData* data) {
+		auto eventInstance = MaterialEvent::GetInstance();
+
+		if (eventInstance != nullptr)
+		{
+			eventInstance->UnloadAndDelete(data);
+		}
+		else
+		{
+			data->Unload();
+			ES_SAFE_DELETE(data);
+		}
+
+		// Unity does not know materials in bundles
+		{
+			std::lock_guard<std::mutex> lock(bundledPathsMutex_);
+			if (bundledPaths_.erase(path) > 0)
+			{
+				return;
+			}
+		}
+
+		unload_(path.c_str(), nullptr);
+	});
+}
+
+std::mutex MaterialLoader::borrowEventMutex_;
+MaterialLoaderBorrowEvent MaterialLoader::borrowEvent_;
+
+void MaterialLoader::SetBorrowEvent(MaterialLoaderBorrow borrow, BorrowedDataGiveBack giveBack)
+{
+	std::lock_guard<std::mutex> lock(borrowEventMutex_);
+	borrowEvent_.Borrow = borrow;
+	borrowEvent_.GiveBack = giveBack;
+}
+
+MaterialLoaderBorrowEvent MaterialLoader::GetBorrowEvent()
+{
+	std::lock_guard<std::mutex> lock(borrowEventMutex_);
+	return borrowEvent_;
 }
 
 Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 {
-	auto it = resources.find((const char16_t*)path);
-	if (it != resources.end())
+	LazyMaterialData* internalData = nullptr;
+	if (resources.Acquire((const char16_t*)path, internalData))
+	{
+		return internalData;
+	}
+
+	if (!LoadBundled(path, internalData))
+	{
+		auto event = GetBorrowEvent();
+		if (event.Borrow != nullptr)
+		{
+			internalData = LoadBorrowed(path, event);
+		}
+		else
+		{
+			internalData = LoadCopied(path);
+		}
+	}
+
+	if (internalData == nullptr)
+	{
+		resources.Cancel((const char16_t*)path);
+		return nullptr;
+	}
+
+	auto eventInstance = MaterialEvent::GetInstance();
+
+	if (eventInstance != nullptr)
+	{
+		eventInstance->Load(internalData);
+	}
+	else
+	{
+		internalData->Load();
+	}
+
+	resources.Add((const char16_t*)path, internalData);
+	return internalData;
+}
+
+bool MaterialLoader::LoadBundled(const EFK_CHAR* path, LazyMaterialData*& internalData)
+{
+	const uint8_t* data = nullptr;
+	size_t dataSize = 0;
+	auto bundle = EffectBundles::FindInAll((const char16_t*)path, data, dataSize);
+	if (bundle == nullptr)
 	{
-		it->second.referenceCount++;
-		return it->second.internalData;
+		return false;
 	}
 
+	// a bundle has only code, which is compiled on the render thread
+	internalData = new LazyMaterialData(internalLoader_, data, static_cast<int32_t>(dataSize), nullptr, 0);
+
+	std::lock_guard<std::mutex> lock(bundledPathsMutex_);
+	bundledPaths_.insert((const char16_t*)path);
+	return true;
+}
+
+LazyMaterialData* MaterialLoader::LoadBorrowed(const EFK_CHAR* path, const MaterialLoaderBorrowEvent& event)
+{
+	// Unity keeps data until it is given back
+	void* data = nullptr;
+	void* cachedData = nullptr;
+	int dataSize = 0;
+	int cachedDataSize = 0;
+
+	auto materialPtr = event.Borrow((const char16_t*)path, data, dataSize, cachedData, cachedDataSize);
+	if (materialPtr == nullptr)
+	{
+		return nullptr;
+	}
+
+	BorrowedData borrowed((const char16_t*)path, event.GiveBack);
+	if ((data == nullptr || dataSize <= 0) && (cachedData == nullptr || cachedDataSize <= 0))
+	{
+		unload_((const char16_t*)path, nullptr);
+		return nullptr;
+	}
+
+	// data is copied once because it is compiled on the render thread later
+	return new LazyMaterialData(internalLoader_,
+								static_cast<const uint8_t*>(data),
+								data != nullptr ? dataSize : 0,
+								static_cast<const uint8_t*>(cachedData),
+								cachedData != nullptr ? cachedDataSize : 0);
+}
+
+LazyMaterialData* MaterialLoader::LoadCopied(const EFK_CHAR* path)
+{
 	// Load with unity
-	MaterialResource res;
+	MemoryBufferPool::Lease buffer(buffers_);
+	MemoryBufferPool::Lease bufferForCache(buffers_);
 	int requiredDataSize = 0;
 	int requiredCachedDataSize = 0;
 
 	auto materialPtr = load_((const char16_t*)path,
-							 &memoryFile_.LoadedBuffer[0],
-							 (int)memoryFile_.LoadedBuffer.size(),
+							 buffer.GetData(),
+							 (int)buffer.GetSize(),
 							 requiredDataSize,
-							 &memoryFileForCache_.LoadedBuffer[0],
-							 (int)memoryFileForCache_.LoadedBuffer.size(),
+							 bufferForCache.GetData(),
+							 (int)bufferForCache.GetSize(),
 							 requiredCachedDataSize);
 
 	if (requiredDataSize == 0 && requiredCachedDataSize == 0)
@@ -176,16 +567,16 @@ Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 	if (materialPtr == nullptr)
 	{
 		// Lack of memory
-		memoryFileForCache_.Resize(requiredCachedDataSize);
-		memoryFile_.Resize(requiredDataSize);
+		bufferForCache.Resize(requiredCachedDataSize);
+		buffer.Resize(requiredDataSize);
 
 		// Load with unity
 		materialPtr = load_((const char16_t*)path,
-							&memoryFile_.LoadedBuffer[0],
-							(int)memoryFile_.LoadedBuffer.size(),
+							buffer.GetData(),
+							(int)buffer.GetSize(),
 							requiredDataSize,
-							&memoryFileForCache_.LoadedBuffer[0],
-							(int)memoryFileForCache_.LoadedBuffer.size(),
+							bufferForCache.GetData(),
+							(int)bufferForCache.GetSize(),
 							requiredCachedDataSize);
 
 		if (materialPtr == nullptr)
@@ -195,40 +586,11 @@ Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 		}
 	}
 
-	// try to load from caches
-	if (requiredCachedDataSize > 0)
-	{
-		memoryFileForCache_.LoadedSize = static_cast<size_t>(requiredCachedDataSize);
-	}
-
-	// try to load from code
-	if (requiredDataSize > 0)
+	// try to load from caches or code
+	if (requiredCachedDataSize > 0 || requiredDataSize > 0)
 	{
-		memoryFile_.LoadedSize = static_cast<size_t>(requiredDataSize);
-	}
-
-	if (memoryFileForCache_.LoadedSize > 0 || memoryFile_.LoadedSize > 0)
-	{
-		auto data = new LazyMaterialData(internalLoader_,
-										 memoryFile_.LoadedBuffer,
-										 memoryFile_.LoadedSize,
-										 memoryFileForCache_.LoadedBuffer,
-										 memoryFileForCache_.LoadedSize);
-		res.internalData = data;
-
-		auto eventInstance = MaterialEvent::GetInstance();
-
-		if (eventInstance != nullptr)
-		{
-			eventInstance->Load(data);
-		}
-		else
-		{
-			data->Load();
-		}
-
-		resources.insert(std::make_pair((const char16_t*)path, res));
-		return res.internalData;
+		return new LazyMaterialData(
+			internalLoader_, buffer.GetData(), requiredDataSize, bufferForCache.GetData(), requiredCachedDataSize);
 	}
 
 	return nullptr;
@@ -240,31 +602,34 @@ void MaterialLoader::Unload(Effekseer::MaterialData* data)
 		return;
 	}
 
-	auto it = std::find_if(resources.begin(), resources.end(), [data](const std::pair<std::u16string, MaterialResource>& pair) {
-		return pair.second.internalData == data;
-	});
-	if (it == resources.end())
-	{
-		return;
-	}
+	resources.Release(static_cast<LazyMaterialData*>(data));
+}
+} // namespace EffekseerPlugin
 
-	it->second.referenceCount--;
-	if (it->second.referenceCount <= 0)
-	{
-		auto eventInstance = MaterialEvent::GetInstance();
+using namespace EffekseerPlugin;
 
-		if (eventInstance != nullptr)
+extern "C"
+{
+	// spread compiling materials over frames
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetMaterialLoadBudget(float maxMilliseconds, int maxCount)
+	{
+		auto instance = MaterialEvent::GetInstance();
+		if (instance == nullptr)
 		{
-			eventInstance->UnloadAndDelete(it->second.internalData);
+			return;
 		}
-		else
+
+		instance->SetBudget(maxMilliseconds, maxCount);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetPendingMaterialCount()
+	{
+		auto instance = MaterialEvent::GetInstance();
+		if (instance == nullptr)
 		{
-			it->second.internalData->Unload();
-			ES_SAFE_DELETE(it->second.internalData);
+			return 0;
 		}
 
-		unload_(it->first.c_str(), nullptr);
-		resources.erase(it);
+		return instance->GetPendingCount();
 	}
 }
-} // namespace EffekseerPlugin
\ No newline at end of file
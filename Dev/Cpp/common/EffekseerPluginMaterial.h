@@ -3,6 +3,7 @@
 
 #include "../unity/IUnityInterface.h"
 #include "EffekseerPluginCommon.h"
+#include "EffekseerPluginResourceRegistry.h"
 #include "MemoryFile.h"
 
 #ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
@@ -11,10 +12,10 @@
 #include <Effekseer.h>
 #endif
 
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
 
 namespace EffekseerPlugin
 {
@@ -28,33 +29,65 @@ using MaterialLoaderLoad = void*(UNITY_INTERFACE_API*)(const char16_t* path,
 
 using MaterialLoaderUnload = void(UNITY_INTERFACE_API*)(const char16_t* path, void* materialPointer);
 
+//! return a material and data which is owned by Unity instead of copying it
+using MaterialLoaderBorrow = void*(UNITY_INTERFACE_API*)(const char16_t* path,
+														 void*& materialData,
+														 int& materialDataSize,
+														 void*& cachedMaterialData,
+														 int& cachedMaterialDataSize);
+
+struct MaterialLoaderBorrowEvent
+{
+	MaterialLoaderBorrow Borrow = nullptr;
+	BorrowedDataGiveBack GiveBack = nullptr;
+};
+
 class LazyMaterialData;
 
 /**
 	@vrief	an event queue of material
 	@note
 	be careful
+	Loads compile shaders, so they are spread over frames within a budget.
+	Unloads are not limited because they are cheap.
+	A material which waits for loading has no shaders and its counts are zero, and renderers do not check it.
+	So a handle of an effect whose materials wait is hidden until they are loaded,
+	and visibility which is specified meanwhile is applied after that.
 */
 class MaterialEvent
 {
 private:
-	enum class CommandType
-	{
-		Load,
-		UnloadAndDelete,
-	};
-
-	struct Command
+	struct PendingHandle
 	{
-		CommandType type = CommandType::Load;
-		LazyMaterialData* data = nullptr;
+		Effekseer::Manager* Manager = nullptr;
+		Effekseer::Handle Handle = -1;
+		Effekseer::Effect* Effect = nullptr;
+		//! visibility which is applied when materials are loaded
+		bool Shown = true;
 	};
 
 	std::mutex mtx_;
-	Effekseer::CustomVector<Command> commands_;
+	//! materials which wait for loading in order
+	Effekseer::CustomVector<LazyMaterialData*> loads_;
+	//! a material which is loaded now outside the lock
+	LazyMaterialData* loading_ = nullptr;
+	Effekseer::CustomVector<LazyMaterialData*> unloads_;
+	Effekseer::CustomVector<PendingHandle> pendingHandles_;
+
+	float maxMilliseconds_ = 0.0f;
+	int32_t maxCount_ = 0;
 
 	static std::shared_ptr<MaterialEvent> instance_;
 
+	void Execute(float maxMilliseconds, int32_t maxCount);
+
+	//! load materials of an effect before other materials because it is shown soon
+	void PrioritizeWithoutLock(Effekseer::Effect* effect);
+
+	bool HasPendingMaterialsWithoutLock(Effekseer::Effect* effect) const;
+
+	PendingHandle* FindPendingHandleWithoutLock(Effekseer::Manager* manager, Effekseer::Handle handle);
+
 public:
 
 	static void Initialize();
@@ -67,7 +100,42 @@ public:
 
 	void UnloadAndDelete(LazyMaterialData* data);
 
+	/**
+		@brief	prioritize materials of a played effect and hide a handle while they wait
+		@note
+		Every path which plays an effect with a manager which is drawn calls it.
+	*/
+	static void OnPlayed(Effekseer::Manager* manager, Effekseer::Effect* effect, Effekseer::Handle handle);
+
+	//! set visibility of a handle. it is applied later if the handle is hidden for materials
+	static void SetShown(Effekseer::Manager* manager, Effekseer::Handle handle, bool shown);
+
+	static bool GetShown(Effekseer::Manager* manager, Effekseer::Handle handle);
+
+	//! show handles whose materials are loaded. call it on a thread which plays effects of the manager
+	static void ShowLoadedHandles(Effekseer::Manager* manager);
+
+	//! forget handles of a manager which is destroyed
+	static void RemoveManager(Effekseer::Manager* manager);
+
+	//! whether some materials of an effect wait for loading
+	bool HasPendingMaterials(Effekseer::Effect* effect);
+
+	/**
+		@brief	limit loads in each Execute
+		@note
+		A value which is zero or less means no limit. At least one material is loaded in each Execute.
+	*/
+	void SetBudget(float maxMilliseconds, int32_t maxCount);
+
+	//! execute commands within a budget
 	void Execute();
+
+	//! execute all commands
+	void Flush();
+
+	//! the number of materials which wait for loading
+	int32_t GetPendingCount();
 };
 
 /**
@@ -89,16 +157,21 @@ class MaterialLoader : public Effekseer::MaterialLoader
 	MaterialLoaderLoad load_ = nullptr;
 	MaterialLoaderUnload unload_ = nullptr;
 
-	struct MaterialResource
-	{
-		int referenceCount = 1;
-		LazyMaterialData* internalData;
-	};
-	std::map<std::u16string, MaterialResource> resources;
-	MemoryFile memoryFile_;
-	MemoryFile memoryFileForCache_;
+	ResourceRegistry<LazyMaterialData*> resources;
+	MemoryBufferPool buffers_;
 	std::shared_ptr<MaterialLoaderHolder> internalLoader_;
 
+	std::mutex bundledPathsMutex_;
+	std::unordered_set<std::u16string> bundledPaths_;
+
+	static std::mutex borrowEventMutex_;
+	static MaterialLoaderBorrowEvent borrowEvent_;
+
+	//! return false if a material is not found in bundles
+	bool LoadBundled(const EFK_CHAR* path, LazyMaterialData*& internalData);
+	LazyMaterialData* LoadCopied(const EFK_CHAR* path);
+	LazyMaterialData* LoadBorrowed(const EFK_CHAR* path, const MaterialLoaderBorrowEvent& event);
+
 public:
 	MaterialLoader(MaterialLoaderLoad load, MaterialLoaderUnload unload);
 
@@ -106,6 +179,14 @@ public:
 	Effekseer::MaterialData* Load(const EFK_CHAR* path) override;
 	void Unload(Effekseer::MaterialData* data) override;
 	void SetInternalLoader(const std::shared_ptr<MaterialLoaderHolder>& loader) { internalLoader_ = loader; }
+
+	/**
+		@brief	use data which is lent by Unity instead of the load callback if borrow is not null
+		@note
+		All material loaders use it.
+	*/
+	static void SetBorrowEvent(MaterialLoaderBorrow borrow, BorrowedDataGiveBack giveBack);
+	static MaterialLoaderBorrowEvent GetBorrowEvent();
 };
 
 } // namespace EffekseerPlugin
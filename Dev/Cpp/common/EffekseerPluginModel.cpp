@@ -1,5 +1,6 @@
-﻿#include <algorithm>
-#include "EffekseerPluginModel.h"
+﻿#include "EffekseerPluginModel.h"
+#include "EffekseerPluginBundle.h"
+#include "EffekseerPluginCompression.h"
 
 namespace EffekseerPlugin
 {
@@ -8,21 +9,106 @@ namespace EffekseerPlugin
 		ModelLoaderUnload unload ) 
 		: load( load )
 		, unload( unload )
-		, memoryFile( 1 * 1024 * 1024 )
+		, buffers( 1 * 1024 * 1024 )
 	{
+		resources.SetReleaseCallback([this](const std::u16string& path, void* internalData) {
+			internalLoader->Unload(internalData);
+
+			// Unity does not know models in bundles
+			{
+				std::lock_guard<std::mutex> lock(bundledPathsMutex);
+				if (bundledPaths.erase(path) > 0) {
+					return;
+				}
+			}
+			this->unload(path.c_str(), nullptr);
+		});
+	}
+	std::mutex ModelLoader::borrowEventMutex;
+	ModelLoaderBorrowEvent ModelLoader::borrowEvent;
+
+	void ModelLoader::SetBorrowEvent( ModelLoaderBorrow borrow, BorrowedDataGiveBack giveBack ){
+		std::lock_guard<std::mutex> lock(borrowEventMutex);
+		borrowEvent.Borrow = borrow;
+		borrowEvent.GiveBack = giveBack;
+	}
+
+	ModelLoaderBorrowEvent ModelLoader::GetBorrowEvent(){
+		std::lock_guard<std::mutex> lock(borrowEventMutex);
+		return borrowEvent;
 	}
+
 	void* ModelLoader::Load( const EFK_CHAR* path ){
 		// リソーステーブルを検索して存在したらそれを使う
-		auto it = resources.find((const char16_t*)path);
-		if (it != resources.end()) {
-			it->second.referenceCount++;
-			return it->second.internalData;
+		void* internalData = nullptr;
+		if (resources.Acquire((const char16_t*)path, internalData)) {
+			return internalData;
+		}
+
+		// バンドルにあればUnityを呼ばずに読み込む
+		if (!LoadBundled( path, internalData )) {
+			auto event = GetBorrowEvent();
+			if (event.Borrow != nullptr) {
+				internalData = LoadBorrowed( path, event );
+			}
+			else {
+				internalData = LoadCopied( path );
+			}
+		}
+
+		if (internalData != nullptr) {
+			resources.Add((const char16_t*)path, internalData);
+		}
+		else {
+			resources.Cancel((const char16_t*)path);
+		}
+		return internalData;
+	}
+
+	bool ModelLoader::LoadBundled( const EFK_CHAR* path, void*& internalData ){
+		const uint8_t* data = nullptr;
+		size_t dataSize = 0;
+		auto bundle = EffectBundles::FindInAll((const char16_t*)path, data, dataSize);
+		if (bundle == nullptr) {
+			return false;
+		}
+
+		// 内部ローダがバンドルから直接読み込む
+		internalData = LoadFromMemory( path, data, dataSize );
+
+		if (internalData != nullptr) {
+			std::lock_guard<std::mutex> lock(bundledPathsMutex);
+			bundledPaths.insert((const char16_t*)path);
+		}
+		return true;
+	}
+
+	void* ModelLoader::LoadBorrowed( const EFK_CHAR* path, const ModelLoaderBorrowEvent& event ){
+		// Unity keeps data until it is given back
+		void* data = nullptr;
+		int dataSize = 0;
+		auto modelPtr = event.Borrow((const char16_t*)path, data, dataSize);
+		if (modelPtr == nullptr)
+		{
+			return nullptr;
 		}
 
+		BorrowedData borrowed((const char16_t*)path, event.GiveBack);
+		if (data == nullptr || dataSize <= 0)
+		{
+			unload((const char16_t*)path, nullptr);
+			return nullptr;
+		}
+
+		// 内部ローダがUnityのメモリから直接読み込む
+		return LoadFromMemory( path, (const uint8_t*)data, (size_t)dataSize );
+	}
+
+	void* ModelLoader::LoadCopied( const EFK_CHAR* path ){
 		// Load with unity
-		ModelResource res;
+		MemoryBufferPool::Lease buffer(buffers);
 		int requiredDataSize = 0;
-		auto modelPtr = load((const char16_t*)path, &memoryFile.LoadedBuffer[0], (int)memoryFile.LoadedBuffer.size(), requiredDataSize);
+		auto modelPtr = load((const char16_t*)path, buffer.GetData(), (int)buffer.GetSize(), requiredDataSize);
 
 		if (requiredDataSize == 0)
 		{
@@ -33,10 +119,10 @@ namespace EffekseerPlugin
 		if (modelPtr == nullptr)
 		{
 			// Lack of memory
-			memoryFile.Resize(requiredDataSize);
+			buffer.Resize(requiredDataSize);
 
 			// Load with unity
-			modelPtr = load((const char16_t*)path, &memoryFile.LoadedBuffer[0], (int)memoryFile.LoadedBuffer.size(), requiredDataSize);
+			modelPtr = load((const char16_t*)path, buffer.GetData(), (int)buffer.GetSize(), requiredDataSize);
 
 			if(modelPtr == nullptr)
 			{
@@ -46,34 +132,55 @@ namespace EffekseerPlugin
 		}
 
 		// 内部ローダに渡してロード処理する
-		memoryFile.LoadedSize = (size_t)requiredDataSize;
-		res.internalData = internalLoader->Load( path );
-			
-		resources.insert( std::make_pair(
-			(const char16_t*)path, res ) );
-		return res.internalData;
+		return LoadFromMemory( path, buffer.GetData(), (size_t)requiredDataSize );
+	}
+
+	void* ModelLoader::LoadFromMemory( const EFK_CHAR* path, const uint8_t* data, size_t dataSize ){
+		// 圧縮されていればスクラッチバッファに展開してから読み込む
+		if (Compression::IsCompressed(data, dataSize)) {
+			MemoryBufferPool::Lease buffer(buffers);
+			if (!DecompressIfCompressed(data, dataSize, buffer.Get())) {
+				return nullptr;
+			}
+			return LoadFromMemory( path, data, dataSize );
+		}
+
+		memoryFile.Bind(const_cast<uint8_t*>(data), dataSize);
+		auto internalData = internalLoader->Load( path );
+		memoryFile.Unbind();
+		return internalData;
 	}
 	void ModelLoader::Unload( void* source ){
 		if (source == nullptr) {
 			return;
 		}
 
-		// アンロードするモデルを検索
-		auto it = std::find_if(resources.begin(), resources.end(), 
-			[source](const std::pair<std::u16string, ModelResource>& pair){
-				return pair.second.internalData == source;
-			});
-		if (it == resources.end()) {
-			return;
+		// 参照カウンタが0になったら実際にアンロード
+		resources.Release(source);
+	}
+}
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	// models are parsed in C# with the Unity renderer, so a compressed container is decompressed for it
+	// return a decompressed size, -1 if data is not a container or 0 if a container is broken
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetDecompressedSize(const void* data, int size)
+	{
+		if (data == nullptr || size <= 0 || !Compression::IsCompressed(data, static_cast<size_t>(size))) {
+			return -1;
 		}
 
-		// 参照カウンタが0になったら実際にアンロード
-		it->second.referenceCount--;
-		if (it->second.referenceCount <= 0)
-		{
-			internalLoader->Unload(it->second.internalData);
-			unload(it->first.c_str(), nullptr);
-			resources.erase(it);
+		return static_cast<int>(Compression::GetDecompressedSize(data, static_cast<size_t>(size)));
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerDecompress(const void* data, int size, void* dst, int dstSize)
+	{
+		if (data == nullptr || size <= 0 || dst == nullptr || dstSize <= 0) {
+			return 0;
 		}
+
+		return Compression::Decompress(data, static_cast<size_t>(size), dst, static_cast<size_t>(dstSize)) ? 1 : 0;
 	}
 }
\ No newline at end of file
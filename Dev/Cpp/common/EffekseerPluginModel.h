@@ -3,8 +3,9 @@
 #define __EFFEKSEER_PLUGIN_MODEL_H__
 
 #include <string>
-#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 #ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
 #include <Effekseer/Effekseer.h>
@@ -13,6 +14,7 @@
 #endif
 
 #include "MemoryFile.h"
+#include "EffekseerPluginResourceRegistry.h"
 #include "EffekseerPluginCommon.h"
 #include "../unity/IUnityInterface.h"
 
@@ -21,19 +23,38 @@ namespace EffekseerPlugin
 	using ModelLoaderLoad = void* (UNITY_INTERFACE_API*)(const char16_t* path, void* data, int dataSize, int& requiredDataSize);
 	using ModelLoaderUnload = void (UNITY_INTERFACE_API*)(const char16_t* path, void* modelPointer);
 
+	//! return a model and data which is owned by Unity instead of copying it
+	using ModelLoaderBorrow = void* (UNITY_INTERFACE_API*)(const char16_t* path, void*& data, int& dataSize);
+
+	struct ModelLoaderBorrowEvent
+	{
+		ModelLoaderBorrow Borrow = nullptr;
+		BorrowedDataGiveBack GiveBack = nullptr;
+	};
+
 	class ModelLoader : public Effekseer::ModelLoader
 	{
 		ModelLoaderLoad load;
 		ModelLoaderUnload unload;
 		
-		struct ModelResource {
-			int referenceCount = 1;
-			void* internalData;
-		};
-		std::map<std::u16string, ModelResource> resources;
+		ResourceRegistry<void*> resources;
+		MemoryBufferPool buffers;
 		MemoryFile memoryFile;
 
 		std::unique_ptr<Effekseer::ModelLoader> internalLoader;
+
+		std::mutex bundledPathsMutex;
+		std::unordered_set<std::u16string> bundledPaths;
+
+		static std::mutex borrowEventMutex;
+		static ModelLoaderBorrowEvent borrowEvent;
+
+		//! return false if a model is not found in bundles
+		bool LoadBundled( const EFK_CHAR* path, void*& internalData );
+		void* LoadCopied( const EFK_CHAR* path );
+		//! load raw or compressed data with the internal loader
+		void* LoadFromMemory( const EFK_CHAR* path, const uint8_t* data, size_t dataSize );
+		void* LoadBorrowed( const EFK_CHAR* path, const ModelLoaderBorrowEvent& event );
 		
 	public:
 		static Effekseer::ModelLoader* Create(
@@ -54,6 +75,14 @@ namespace EffekseerPlugin
 		void SetInternalLoader( Effekseer::ModelLoader* loader ) {
 			internalLoader.reset( loader );
 		}
+
+		/**
+			@brief	use data which is lent by Unity instead of the load callback if borrow is not null
+			@note
+			All model loaders use it.
+		*/
+		static void SetBorrowEvent( ModelLoaderBorrow borrow, BorrowedDataGiveBack giveBack );
+		static ModelLoaderBorrowEvent GetBorrowEvent();
 	};
 	
 }
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a table of loaded resources which is searched by a path and by a resource
+	@note
+	Both tables are hashed, so loading and unloading cost constant time regardless of the number of resources.
+	A resource is released with a callback when its reference count becomes zero.
+	It can be used from several threads. A path which is loaded by a thread is waited by other threads
+	instead of being loaded twice.
+*/
+template <typename TResource> class ResourceRegistry
+{
+public:
+	using ReleaseCallback = std::function<void(const std::u16string& path, TResource resource)>;
+
+private:
+	struct Entry
+	{
+		TResource Resource;
+		int32_t ReferenceCount = 1;
+	};
+
+	using PathTable = std::unordered_map<std::u16string, Entry>;
+
+	std::mutex mtx_;
+	std::condition_variable loadedCondition_;
+
+	PathTable paths_;
+
+	//! nodes of an unordered_map are not moved by a rehash
+	std::unordered_map<TResource, typename PathTable::value_type*> resources_;
+
+	//! paths which are loaded now
+	std::unordered_set<std::u16string> loadingPaths_;
+
+	ReleaseCallback release_;
+
+	void AddWithoutLock(const std::u16string& path, TResource resource)
+	{
+		auto added = paths_.emplace(path, Entry());
+		if (!added.second)
+		{
+			added.first->second.ReferenceCount++;
+			return;
+		}
+
+		added.first->second.Resource = resource;
+		resources_[resource] = &(*added.first);
+	}
+
+public:
+	ResourceRegistry() = default;
+
+	explicit ResourceRegistry(const ReleaseCallback& release) : release_(release) {}
+
+	void SetReleaseCallback(const ReleaseCallback& release) { release_ = release; }
+
+	/**
+		@brief	find a resource with a path and add a reference
+		@return	whether it is found
+		@note
+		If it is not found, the caller must load it and call Add or Cancel with the path.
+		If the path is loaded by another thread, it waits for the thread.
+	*/
+	bool Acquire(const char16_t* path, TResource& resource)
+	{
+		std::unique_lock<std::mutex> lock(mtx_);
+		std::u16string key(path);
+
+		loadedCondition_.wait(lock, [this, &key]() { return loadingPaths_.count(key) == 0; });
+
+		auto it = paths_.find(key);
+		if (it == paths_.end())
+		{
+			loadingPaths_.insert(key);
+			return false;
+		}
+
+		it->second.ReferenceCount++;
+		resource = it->second.Resource;
+		return true;
+	}
+
+	//! register a loaded resource with a reference
+	void Add(const char16_t* path, TResource resource)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			std::u16string key(path);
+			AddWithoutLock(key, resource);
+			loadingPaths_.erase(key);
+		}
+		loadedCondition_.notify_all();
+	}
+
+	//! finish loading a path which is failed
+	void Cancel(const char16_t* path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			loadingPaths_.erase(path);
+		}
+		loadedCondition_.notify_all();
+	}
+
+	/**
+		@brief	remove a reference and release a resource with a callback if it is not referred
+		@return	whether it is found
+	*/
+	bool Release(TResource resource)
+	{
+		std::u16string path;
+
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+
+			auto it = resources_.find(resource);
+			if (it == resources_.end())
+			{
+				return false;
+			}
+
+			auto node = it->second;
+			node->second.ReferenceCount--;
+			if (node->second.ReferenceCount > 0)
+			{
+				return true;
+			}
+
+			resources_.erase(it);
+
+			// a path is kept until the callback is finished
+			path = node->first;
+			paths_.erase(path);
+		}
+
+		// the callback may call back into Unity, so it is called without the lock
+		if (release_ != nullptr)
+		{
+			release_(path, resource);
+		}
+		return true;
+	}
+
+	bool Contains(TResource resource)
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		return resources_.count(resource) > 0;
+	}
+
+	size_t GetCount()
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		return paths_.size();
+	}
+};
+
+} // namespace EffekseerPlugin
@@ -0,0 +1,820 @@
+#include "EffekseerPluginScheduler.h"
+#include "EffekseerPluginGroup.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+Frustum Frustum::Create(const Effekseer::Matrix44& cameraMatrix, const Effekseer::Matrix44& projectionMatrix)
+{
+	// a clip position is calculated as position * camera * projection
+	float m[4][4];
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			m[r][c] = 0.0f;
+			for (int k = 0; k < 4; k++)
+			{
+				m[r][c] += cameraMatrix.Values[r][k] * projectionMatrix.Values[k][c];
+			}
+		}
+	}
+
+	// left, right, bottom and top. near and far are ignored because they depend on a graphics API and reversed depth
+	const int axes[4] = {0, 0, 1, 1};
+	const float signs[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+
+	Frustum frustum;
+	for (int i = 0; i < 4; i++)
+	{
+		auto& plane = frustum.Planes[i];
+		for (int r = 0; r < 4; r++)
+		{
+			plane[r] = m[r][3] + signs[i] * m[r][axes[i]];
+		}
+
+		auto length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+		if (length > 0.0f)
+		{
+			for (auto& v : plane)
+			{
+				v /= length;
+			}
+		}
+	}
+
+	return frustum;
+}
+
+bool Frustum::IsInside(const Effekseer::Vector3D& position, float radius) const
+{
+	for (const auto& plane : Planes)
+	{
+		if (plane[0] * position.X + plane[1] * position.Y + plane[2] * position.Z + plane[3] < -radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::shared_ptr<UpdateScheduler> UpdateScheduler::instance_;
+
+void UpdateScheduler::Initialize() { instance_ = std::make_shared<UpdateScheduler>(); }
+
+void UpdateScheduler::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<UpdateScheduler> UpdateScheduler::GetInstance() { return instance_; }
+
+void UpdateScheduler::SetSpeed(Effekseer::Manager* manager, int32_t handle, float speed)
+{
+	auto scheduler = GetInstance();
+	if (scheduler != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(scheduler->mtx_);
+		auto it = scheduler->handles_.find(handle);
+		if (it != scheduler->handles_.end())
+		{
+			// applied when the handle is updated next time
+			it->second.Speed = speed;
+			if (!scheduler->IsActiveWithoutLock())
+			{
+				manager->SetSpeed(handle, speed);
+			}
+			return;
+		}
+	}
+
+	manager->SetSpeed(handle, speed);
+}
+
+float UpdateScheduler::GetSpeed(Effekseer::Manager* manager, int32_t handle)
+{
+	auto scheduler = GetInstance();
+	if (scheduler != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(scheduler->mtx_);
+		auto it = scheduler->handles_.find(handle);
+		if (it != scheduler->handles_.end())
+		{
+			return it->second.Speed;
+		}
+	}
+
+	return manager->GetSpeed(handle);
+}
+
+void UpdateScheduler::ResetWithoutLock(Effekseer::Manager* manager)
+{
+	// banked frames are dropped to avoid a sudden jump
+	for (auto& pair : handles_)
+	{
+		pair.second.BankedFrames = 0.0f;
+		pair.second.Counter = 0;
+		pair.second.CulledFrames = 0;
+		pair.second.IsSuspended = false;
+		manager->SetSpeed(pair.first, pair.second.Speed);
+	}
+	stats_ = Stats();
+}
+
+void UpdateScheduler::SetEnabled(Effekseer::Manager* manager, bool enabled)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	if (isEnabled_ == enabled)
+	{
+		return;
+	}
+
+	isEnabled_ = enabled;
+
+	if (!IsActiveWithoutLock())
+	{
+		ResetWithoutLock(manager);
+	}
+}
+
+void UpdateScheduler::SetSuspension(Effekseer::Manager* manager, bool enabled, int32_t suspensionFrames, float maxCatchUpFrames)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	suspensionFrames_ = std::max(1, suspensionFrames);
+	maxCatchUpFrames_ = std::max(0.0f, maxCatchUpFrames);
+
+	if (isSuspensionEnabled_ == enabled)
+	{
+		return;
+	}
+
+	isSuspensionEnabled_ = enabled;
+
+	if (!IsActiveWithoutLock())
+	{
+		ResetWithoutLock(manager);
+	}
+}
+
+void UpdateScheduler::SetThresholds(const float* distances, const int32_t* intervals, int32_t count, int32_t culledInterval)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	thresholds_.clear();
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		thresholds_.push_back(Threshold{distances[i], std::max(1, intervals[i])});
+	}
+
+	std::sort(thresholds_.begin(), thresholds_.end(), [](const Threshold& a, const Threshold& b) { return a.Distance < b.Distance; });
+
+	culledInterval_ = std::max(1, culledInterval);
+}
+
+void UpdateScheduler::SetBudget(Effekseer::Manager* manager, int32_t microseconds)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	budget_ = std::max(0, microseconds);
+	overrunCount_ = 0;
+
+	if (!IsActiveWithoutLock())
+	{
+		ResetWithoutLock(manager);
+	}
+}
+
+void UpdateScheduler::SetPriority(Effekseer::Manager* manager, int32_t handle, int32_t priority)
+{
+	if (handle < 0 || !manager->Exists(handle))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+	priorities_[handle] = priority;
+}
+
+void UpdateScheduler::SetGroupPriority(int32_t group, int32_t priority)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	groupPriorities_[group] = priority;
+}
+
+UpdateScheduler::HandleState* UpdateScheduler::AddWithoutLock(Effekseer::Manager* manager, int32_t handle)
+{
+	auto it = handles_.find(handle);
+	if (it != handles_.end())
+	{
+		return &(it->second);
+	}
+
+	HandleState state;
+	state.Speed = manager->GetSpeed(handle);
+	return &(handles_[handle] = state);
+}
+
+void UpdateScheduler::Register(Effekseer::Manager* manager, int32_t handle, float radius)
+{
+	if (handle < 0 || !manager->Exists(handle))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto state = AddWithoutLock(manager, handle);
+	state->IsScheduled = true;
+	state->Radius = radius;
+}
+
+void UpdateScheduler::Unregister(Effekseer::Manager* manager, int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return;
+	}
+
+	if (manager->Exists(handle))
+	{
+		manager->SetSpeed(handle, it->second.Speed);
+	}
+
+	handles_.erase(it);
+}
+
+void UpdateScheduler::NotifyCamera(int32_t renderId)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	nextRenderIds_.insert(renderId);
+}
+
+void UpdateScheduler::RemoveCamera(int32_t renderId)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	activeRenderIds_.erase(renderId);
+	nextRenderIds_.erase(renderId);
+}
+
+std::vector<Effekseer::Vector3D> UpdateScheduler::GetCameraPositions()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return cameraPositions_;
+}
+
+int32_t UpdateScheduler::CalculateInterval(HandleState& state,
+										   const Effekseer::Vector3D& position,
+										   const std::vector<Effekseer::Vector3D>& cameraPositions,
+										   const std::vector<Frustum>& frustums) const
+{
+	if (cameraPositions.empty())
+	{
+		state.IsCulled = false;
+		return 1;
+	}
+
+	state.IsCulled = std::none_of(
+		frustums.begin(), frustums.end(), [&](const Frustum& frustum) { return frustum.IsInside(position, state.Radius); });
+
+	if (!isEnabled_)
+	{
+		return 1;
+	}
+
+	if (state.IsCulled)
+	{
+		return culledInterval_;
+	}
+
+	auto nearest = std::numeric_limits<float>::max();
+	for (const auto& cameraPosition : cameraPositions)
+	{
+		auto dx = position.X - cameraPosition.X;
+		auto dy = position.Y - cameraPosition.Y;
+		auto dz = position.Z - cameraPosition.Z;
+		nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy + dz * dz) - state.Radius);
+	}
+
+	int32_t interval = 1;
+	for (const auto& threshold : thresholds_)
+	{
+		if (nearest < threshold.Distance)
+		{
+			break;
+		}
+		interval = threshold.Interval;
+	}
+
+	return interval;
+}
+
+std::vector<std::pair<int32_t, int32_t>> UpdateScheduler::GatherGroupPriorities(Effekseer::Manager* manager)
+{
+	std::vector<std::pair<int32_t, int32_t>> handlePriorities;
+
+	std::unordered_map<int32_t, int32_t> groupPriorities;
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		if (budget_ > 0)
+		{
+			groupPriorities = groupPriorities_;
+		}
+	}
+
+	// EffectGroups is accessed without a lock of the scheduler because EffectGroups calls SetSpeed while it is locked
+	auto groups = EffectGroups::GetInstance();
+	if (groups == nullptr)
+	{
+		return handlePriorities;
+	}
+
+	for (const auto& pair : groupPriorities)
+	{
+		auto priority = pair.second;
+		groups->ForEach(manager, pair.first, [&](int32_t handle) { handlePriorities.emplace_back(handle, priority); });
+	}
+
+	return handlePriorities;
+}
+
+void UpdateScheduler::UpdatePrioritiesWithoutLock(Effekseer::Manager* manager,
+												  const std::vector<std::pair<int32_t, int32_t>>& groupPriorities)
+{
+	std::unordered_map<int32_t, int32_t> handlePriorities;
+	if (budget_ > 0)
+	{
+		for (const auto& pair : groupPriorities)
+		{
+			handlePriorities[pair.first] = pair.second;
+		}
+
+		// a priority of a handle is preferred
+		for (const auto& pair : priorities_)
+		{
+			handlePriorities[pair.first] = pair.second;
+		}
+	}
+
+	for (auto it = handles_.begin(); it != handles_.end();)
+	{
+		if (!it->second.IsScheduled && handlePriorities.count(it->first) == 0)
+		{
+			manager->SetSpeed(it->first, it->second.Speed);
+			it = handles_.erase(it);
+		}
+		else
+		{
+			it->second.Priority = 0;
+			++it;
+		}
+	}
+
+	for (const auto& pair : handlePriorities)
+	{
+		if (manager->Exists(pair.first))
+		{
+			AddWithoutLock(manager, pair.first)->Priority = pair.second;
+		}
+	}
+}
+
+void UpdateScheduler::DeferWithoutLock(Effekseer::Manager* manager, std::vector<std::pair<int32_t, HandleState*>>& ticking)
+{
+	auto estimated = costPerInstance_ * manager->GetTotalInstanceCount();
+	if (estimated <= budget_)
+	{
+		return;
+	}
+
+	std::sort(ticking.begin(), ticking.end(), [](const std::pair<int32_t, HandleState*>& a, const std::pair<int32_t, HandleState*>& b) {
+		return a.second->GetEffectivePriority() < b.second->GetEffectivePriority();
+	});
+
+	for (auto& pair : ticking)
+	{
+		if (estimated <= budget_)
+		{
+			break;
+		}
+
+		pair.second->IsDeferred = true;
+		estimated -= costPerInstance_ * manager->GetInstanceCount(pair.first);
+	}
+}
+
+void UpdateScheduler::BeginUpdate(Effekseer::Manager* manager, float deltaFrame)
+{
+	auto groupPriorities = GatherGroupPriorities(manager);
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::vector<int32_t> removed;
+	for (const auto& pair : handles_)
+	{
+		if (!manager->Exists(pair.first))
+		{
+			removed.push_back(pair.first);
+		}
+	}
+
+	for (auto handle : removed)
+	{
+		handles_.erase(handle);
+	}
+
+	for (auto it = priorities_.begin(); it != priorities_.end();)
+	{
+		it = manager->Exists(it->first) ? std::next(it) : priorities_.erase(it);
+	}
+
+	UpdatePrioritiesWithoutLock(manager, groupPriorities);
+
+	// cameras which were rendered after the previous update
+	if (!nextRenderIds_.empty())
+	{
+		activeRenderIds_.swap(nextRenderIds_);
+		nextRenderIds_.clear();
+	}
+
+	auto& cameraPositions = cameraPositions_;
+	std::vector<Frustum> frustums;
+	cameraPositions.clear();
+
+	for (auto renderId : activeRenderIds_)
+	{
+		if (renderId < 0 || renderId >= MAX_RENDER_PATH)
+		{
+			continue;
+		}
+
+		const auto& settings = renderSettings[renderId];
+		Effekseer::Vector3D direction, position;
+		CalculateCameraDirectionAndPosition(settings.cameraMatrix, direction, position);
+		cameraPositions.push_back(position);
+
+		if (settings.stereoEnabled)
+		{
+			frustums.push_back(Frustum::Create(settings.leftCameraMatrix, settings.leftProjectionMatrix));
+			frustums.push_back(Frustum::Create(settings.rightCameraMatrix, settings.rightProjectionMatrix));
+		}
+		else
+		{
+			frustums.push_back(Frustum::Create(settings.cameraMatrix, settings.projectionMatrix));
+		}
+	}
+
+	if (!IsActiveWithoutLock())
+	{
+		return;
+	}
+
+	stats_ = Stats();
+	stats_.ScheduledCount = static_cast<int32_t>(
+		std::count_if(handles_.begin(), handles_.end(), [](const std::pair<const int32_t, HandleState>& pair) { return pair.second.IsScheduled; }));
+
+	std::vector<std::pair<int32_t, HandleState*>> ticking;
+
+	for (auto& pair : handles_)
+	{
+		auto handle = pair.first;
+		auto& state = pair.second;
+
+		if (deltaFrame <= 0.0f)
+		{
+			manager->SetSpeed(handle, state.Speed);
+			continue;
+		}
+
+		// a handle which is tracked only for a budget is updated every frame unless it is deferred
+		state.Interval = state.IsScheduled ? CalculateInterval(state, manager->GetLocation(handle), cameraPositions, frustums) : 1;
+		state.Counter++;
+		state.BankedFrames += deltaFrame;
+		state.CulledFrames = state.IsCulled ? state.CulledFrames + 1 : 0;
+
+		if (isSuspensionEnabled_ && state.CulledFrames >= suspensionFrames_)
+		{
+			state.IsSuspended = true;
+			manager->SetSpeed(handle, 0.0f);
+			stats_.SuspendedCount++;
+			continue;
+		}
+
+		if (state.IsSuspended)
+		{
+			// catch up a looping effect quickly but limit a cost of a long absence
+			state.IsSuspended = false;
+			state.BankedFrames = std::min(state.BankedFrames, std::max(deltaFrame, maxCatchUpFrames_));
+			state.Counter = state.Interval;
+		}
+
+		if (state.Counter >= state.Interval)
+		{
+			state.IsDeferred = false;
+			ticking.emplace_back(handle, &state);
+		}
+		else
+		{
+			manager->SetSpeed(handle, 0.0f);
+			stats_.SkippedCount++;
+		}
+	}
+
+	if (budget_ > 0 && costPerInstance_ > 0.0f)
+	{
+		DeferWithoutLock(manager, ticking);
+	}
+
+	for (const auto& pair : ticking)
+	{
+		auto handle = pair.first;
+		auto& state = *pair.second;
+
+		if (state.IsDeferred)
+		{
+			// updated in the next frame with banked frames
+			manager->SetSpeed(handle, 0.0f);
+			state.DeferredFrames++;
+			stats_.DeferredCount++;
+			continue;
+		}
+
+		manager->SetSpeed(handle, state.Speed * state.BankedFrames / deltaFrame);
+		state.BankedFrames = 0.0f;
+		state.Counter = 0;
+		state.DeferredFrames = 0;
+		state.TickCount++;
+		stats_.TickedCount++;
+	}
+
+	updateStartTime_ = std::chrono::steady_clock::now();
+}
+
+void UpdateScheduler::EndUpdate(Effekseer::Manager* manager)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	if (budget_ <= 0)
+	{
+		return;
+	}
+
+	auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - updateStartTime_).count();
+	stats_.UpdateMicroseconds = elapsed;
+
+	auto instanceCount = manager->GetTotalInstanceCount();
+	if (instanceCount > 0)
+	{
+		// smoothed to avoid oscillation between deferring and updating
+		auto cost = elapsed / instanceCount;
+		costPerInstance_ = costPerInstance_ > 0.0f ? (costPerInstance_ + cost) * 0.5f : cost;
+	}
+
+	if (elapsed > budget_)
+	{
+		overrunCount_++;
+	}
+}
+
+int32_t UpdateScheduler::GetInterval(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return 1;
+	}
+	return it->second.Interval;
+}
+
+int32_t UpdateScheduler::GetTickCount(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return 0;
+	}
+	return it->second.TickCount;
+}
+
+bool UpdateScheduler::GetSuspended(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return false;
+	}
+	return it->second.IsSuspended;
+}
+
+UpdateScheduler::Stats UpdateScheduler::GetStats()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return stats_;
+}
+
+int32_t UpdateScheduler::GetOverrunCount()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	return overrunCount_;
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetUpdateSchedulerEnabled(int enabled)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (g_EffekseerManager == nullptr || scheduler == nullptr)
+		{
+			return;
+		}
+
+		scheduler->SetEnabled(g_EffekseerManager, enabled != 0);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetOffscreenSuspension(int enabled, int suspensionFrames, float maxCatchUpFrames)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (g_EffekseerManager == nullptr || scheduler == nullptr)
+		{
+			return;
+		}
+
+		scheduler->SetSuspension(g_EffekseerManager, enabled != 0, suspensionFrames, maxCatchUpFrames);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetUpdateSchedulerThresholds(const float* distances,
+																						  const int* intervals,
+																						  int count,
+																						  int culledInterval)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler == nullptr || count < 0 || (count > 0 && (distances == nullptr || intervals == nullptr)))
+		{
+			return;
+		}
+
+		scheduler->SetThresholds(distances, intervals, count, culledInterval);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetHandleScheduled(int handle, int scheduled, float radius)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (g_EffekseerManager == nullptr || scheduler == nullptr)
+		{
+			return;
+		}
+
+		if (scheduled != 0)
+		{
+			scheduler->Register(g_EffekseerManager, handle, radius);
+		}
+		else
+		{
+			scheduler->Unregister(g_EffekseerManager, handle);
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetHandleUpdateInterval(int handle)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler == nullptr)
+		{
+			return 1;
+		}
+
+		return scheduler->GetInterval(handle);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetHandleTickCount(int handle)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler == nullptr)
+		{
+			return 0;
+		}
+
+		return scheduler->GetTickCount(handle);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerGetHandleSuspended(int handle)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler == nullptr)
+		{
+			return 0;
+		}
+
+		return scheduler->GetSuspended(handle) ? 1 : 0;
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerGetUpdateSchedulerStats(int* scheduledCount,
+																					 int* tickedCount,
+																					 int* skippedCount,
+																					 int* suspendedCount)
+	{
+		UpdateScheduler::Stats stats;
+
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler != nullptr)
+		{
+			stats = scheduler->GetStats();
+		}
+
+		if (scheduledCount != nullptr)
+		{
+			*scheduledCount = stats.ScheduledCount;
+		}
+
+		if (tickedCount != nullptr)
+		{
+			*tickedCount = stats.TickedCount;
+		}
+
+		if (skippedCount != nullptr)
+		{
+			*skippedCount = stats.SkippedCount;
+		}
+
+		if (suspendedCount != nullptr)
+		{
+			*suspendedCount = stats.SuspendedCount;
+		}
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetUpdateBudget(int microseconds)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (g_EffekseerManager == nullptr || scheduler == nullptr)
+		{
+			return;
+		}
+
+		scheduler->SetBudget(g_EffekseerManager, microseconds);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetHandleUpdatePriority(int handle, int priority)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (g_EffekseerManager == nullptr || scheduler == nullptr)
+		{
+			return;
+		}
+
+		scheduler->SetPriority(g_EffekseerManager, handle, priority);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerSetGroupUpdatePriority(int group, int priority)
+	{
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler == nullptr)
+		{
+			return;
+		}
+
+		scheduler->SetGroupPriority(group, priority);
+	}
+
+	UNITY_INTERFACE_EXPORT void UNITY_INTERFACE_API EffekseerGetUpdateBudgetStats(float* updateMicroseconds, int* deferredCount, int* overrunCount)
+	{
+		UpdateScheduler::Stats stats;
+		int32_t overrun = 0;
+
+		auto scheduler = UpdateScheduler::GetInstance();
+		if (scheduler != nullptr)
+		{
+			stats = scheduler->GetStats();
+			overrun = scheduler->GetOverrunCount();
+		}
+
+		if (updateMicroseconds != nullptr)
+		{
+			*updateMicroseconds = stats.UpdateMicroseconds;
+		}
+
+		if (deferredCount != nullptr)
+		{
+			*deferredCount = stats.DeferredCount;
+		}
+
+		if (overrunCount != nullptr)
+		{
+			*overrunCount = overrun;
+		}
+	}
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	a frustum of a camera to test whether a handle is visible
+*/
+struct Frustum
+{
+	std::array<std::array<float, 4>, 4> Planes;
+
+	//! create from a camera matrix and a projection matrix which are assigned from unity
+	static Frustum Create(const Effekseer::Matrix44& cameraMatrix, const Effekseer::Matrix44& projectionMatrix);
+
+	bool IsInside(const Effekseer::Vector3D& position, float radius) const;
+};
+
+/**
+	@brief	reduce an update rate of handles which are far from cameras or are out of cameras
+	@note
+	Manager::Update updates all handles together. So a skipped handle gets speed 0 and
+	banked frames are applied with a multiplied speed when it is updated next time.
+	Only handles which are registered with Register are scheduled.
+	When a suspension is enabled, a handle which is out of all cameras for some frames is not updated
+	and it is caught up with banked frames up to a limit when it comes back into view.
+	When a budget is specified, handles with low priority are deferred to the next frame
+	if the update time which is estimated from the previous frame exceeds the budget.
+	Handles which have a priority or a group priority are deferred too even if they are not registered,
+	but a priority does not register them for distances and visibility.
+*/
+class UpdateScheduler
+{
+public:
+	struct Stats
+	{
+		int32_t ScheduledCount = 0;
+		int32_t TickedCount = 0;
+		int32_t SkippedCount = 0;
+		int32_t SuspendedCount = 0;
+		int32_t DeferredCount = 0;
+		float UpdateMicroseconds = 0.0f;
+	};
+
+private:
+	struct HandleState
+	{
+		float Speed = 1.0f;
+		float Radius = 1.0f;
+		float BankedFrames = 0.0f;
+		int32_t Interval = 1;
+		int32_t Counter = 0;
+		int32_t TickCount = 0;
+		int32_t CulledFrames = 0;
+		bool IsCulled = false;
+		bool IsSuspended = false;
+		//! registered with Register. otherwise it is tracked only for a budget
+		bool IsScheduled = false;
+		//! a priority of a handle or its group in this frame
+		int32_t Priority = 0;
+		int32_t DeferredFrames = 0;
+		bool IsDeferred = false;
+
+		//! a handle which has been deferred for a long time gets a higher priority
+		int32_t GetEffectivePriority() const { return Priority + DeferredFrames; }
+	};
+
+	struct Threshold
+	{
+		float Distance;
+		int32_t Interval;
+	};
+
+	std::mutex mtx_;
+	bool isEnabled_ = false;
+	std::unordered_map<int32_t, HandleState> handles_;
+	std::vector<Threshold> thresholds_;
+	int32_t culledInterval_ = 4;
+	bool isSuspensionEnabled_ = false;
+	int32_t suspensionFrames_ = 30;
+	float maxCatchUpFrames_ = 60.0f;
+	int32_t budget_ = 0;
+	float costPerInstance_ = 0.0f;
+	int32_t overrunCount_ = 0;
+	std::unordered_map<int32_t, int32_t> priorities_;
+	std::unordered_map<int32_t, int32_t> groupPriorities_;
+	std::chrono::steady_clock::time_point updateStartTime_;
+	std::unordered_set<int32_t> activeRenderIds_;
+	std::unordered_set<int32_t> nextRenderIds_;
+	std::vector<Effekseer::Vector3D> cameraPositions_;
+	Stats stats_;
+
+	static std::shared_ptr<UpdateScheduler> instance_;
+
+	bool IsActiveWithoutLock() const { return isEnabled_ || isSuspensionEnabled_ || budget_ > 0; }
+
+	void ResetWithoutLock(Effekseer::Manager* manager);
+
+	HandleState* AddWithoutLock(Effekseer::Manager* manager, int32_t handle);
+
+	//! track handles which have priorities while a budget is specified and release others which are not scheduled
+	void UpdatePrioritiesWithoutLock(Effekseer::Manager* manager, const std::vector<std::pair<int32_t, int32_t>>& groupPriorities);
+
+	std::vector<std::pair<int32_t, int32_t>> GatherGroupPriorities(Effekseer::Manager* manager);
+
+	void DeferWithoutLock(Effekseer::Manager* manager, std::vector<std::pair<int32_t, HandleState*>>& ticking);
+
+	int32_t CalculateInterval(HandleState& state,
+							  const Effekseer::Vector3D& position,
+							  const std::vector<Effekseer::Vector3D>& cameraPositions,
+							  const std::vector<Frustum>& frustums) const;
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<UpdateScheduler> GetInstance();
+
+	//! set a speed through a scheduler if the handle is scheduled
+	static void SetSpeed(Effekseer::Manager* manager, int32_t handle, float speed);
+
+	//! get a speed which is specified by a user
+	static float GetSpeed(Effekseer::Manager* manager, int32_t handle);
+
+	void SetEnabled(Effekseer::Manager* manager, bool enabled);
+
+	//! intervals are selected by a distance to the nearest camera. distances must be sorted in ascending order
+	/**
+		@brief	suspend handles which are out of all cameras for suspensionFrames frames
+		@param	maxCatchUpFrames	the maximum of frames which are applied when a suspended handle comes back into view
+	*/
+	void SetSuspension(Effekseer::Manager* manager, bool enabled, int32_t suspensionFrames, float maxCatchUpFrames);
+
+	//! a budget of Manager::Update in microseconds. 0 means no budget
+	void SetBudget(Effekseer::Manager* manager, int32_t microseconds);
+
+	//! a priority of a handle which is used with a budget. a higher priority is updated first
+	void SetPriority(Effekseer::Manager* manager, int32_t handle, int32_t priority);
+
+	//! a priority of handles in a group which is used with a budget. a priority of a handle is preferred
+	void SetGroupPriority(int32_t group, int32_t priority);
+
+	void SetThresholds(const float* distances, const int32_t* intervals, int32_t count, int32_t culledInterval);
+
+	void Register(Effekseer::Manager* manager, int32_t handle, float radius);
+
+	void Unregister(Effekseer::Manager* manager, int32_t handle);
+
+	//! a camera which is rendered in this frame
+	void NotifyCamera(int32_t renderId);
+
+	void RemoveCamera(int32_t renderId);
+
+	//! positions of cameras which were rendered before the last update
+	std::vector<Effekseer::Vector3D> GetCameraPositions();
+
+	//! call before Manager::Update
+	void BeginUpdate(Effekseer::Manager* manager, float deltaFrame);
+
+	//! call after Manager::Update
+	void EndUpdate(Effekseer::Manager* manager);
+
+	int32_t GetInterval(int32_t handle);
+
+	int32_t GetTickCount(int32_t handle);
+
+	bool GetSuspended(int32_t handle);
+
+	Stats GetStats();
+
+	//! the number of frames which exceeded a budget
+	int32_t GetOverrunCount();
+};
+
+} // namespace EffekseerPlugin
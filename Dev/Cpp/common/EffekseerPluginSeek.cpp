@@ -0,0 +1,211 @@
+#include "EffekseerPluginSeek.h"
+#include "EffekseerPluginBudget.h"
+#include "EffekseerPluginMaterial.h"
+#include "EffekseerPluginScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace EffekseerPlugin
+{
+extern Effekseer::Manager* g_EffekseerManager;
+
+std::shared_ptr<SeekableHandles> SeekableHandles::instance_;
+
+void SeekableHandles::Initialize() { instance_ = std::make_shared<SeekableHandles>(); }
+
+void SeekableHandles::Terminate() { instance_ = nullptr; }
+
+std::shared_ptr<SeekableHandles> SeekableHandles::GetInstance() { return instance_; }
+
+SeekableHandles::~SeekableHandles()
+{
+	for (auto& pair : handles_)
+	{
+		ES_SAFE_RELEASE(pair.second.Effect);
+	}
+}
+
+void SeekableHandles::RemoveWithoutLock(int32_t handle)
+{
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return;
+	}
+
+	ES_SAFE_RELEASE(it->second.Effect);
+	handles_.erase(it);
+}
+
+Effekseer::Handle
+SeekableHandles::Play(Effekseer::Manager* manager, Effekseer::Effect* effect, const Effekseer::Vector3D& position, float frame)
+{
+	frame = std::max(0.0f, frame);
+	auto startFrame = static_cast<int32_t>(std::floor(frame));
+
+	auto handle = InstanceBudget::Play(manager, effect, position, startFrame);
+	if (handle < 0)
+	{
+		return handle;
+	}
+	MaterialEvent::OnPlayed(manager, effect, handle);
+
+	if (frame > startFrame)
+	{
+		manager->BeginUpdate();
+		manager->UpdateHandle(handle, frame - startFrame);
+		manager->EndUpdate();
+	}
+
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	// the effect is kept to play it again
+	HandleState state;
+	state.Effect = effect;
+	state.Frame = frame;
+	ES_SAFE_ADDREF(state.Effect);
+	handles_[handle] = state;
+
+	return handle;
+}
+
+Effekseer::Handle SeekableHandles::Seek(Effekseer::Manager* manager, int32_t handle, float frame)
+{
+	frame = std::max(0.0f, frame);
+
+	Effekseer::Effect* effect = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+
+		auto it = handles_.find(handle);
+		if (it == handles_.end())
+		{
+			return handle;
+		}
+
+		auto& state = it->second;
+
+		if (frame >= state.Frame && manager->Exists(handle))
+		{
+			auto delta = frame - state.Frame;
+
+			manager->BeginUpdate();
+			while (delta > 0.0f)
+			{
+				auto step = std::min(delta, 1.0f);
+				manager->UpdateHandle(handle, step);
+				delta -= step;
+			}
+			manager->EndUpdate();
+
+			state.Frame = frame;
+			return handle;
+		}
+
+		effect = state.Effect;
+		ES_SAFE_ADDREF(effect);
+		RemoveWithoutLock(handle);
+	}
+
+	// play again from the frame with the same transform and visibility
+	Effekseer::Handle newHandle = -1;
+
+	if (manager->Exists(handle))
+	{
+		auto matrix = manager->GetMatrix(handle);
+		auto shown = MaterialEvent::GetShown(manager, handle);
+		auto layer = manager->GetLayer(handle);
+		auto speed = UpdateScheduler::GetSpeed(manager, handle);
+		manager->StopEffect(handle);
+
+		newHandle = Play(manager, effect, Effekseer::Vector3D(matrix.Value[3][0], matrix.Value[3][1], matrix.Value[3][2]), frame);
+		if (newHandle >= 0)
+		{
+			manager->SetMatrix(newHandle, matrix);
+			MaterialEvent::SetShown(manager, newHandle, shown);
+			manager->SetLayer(newHandle, layer);
+			manager->SetSpeed(newHandle, speed);
+		}
+	}
+	else
+	{
+		newHandle = Play(manager, effect, Effekseer::Vector3D(), frame);
+	}
+
+	ES_SAFE_RELEASE(effect);
+
+	return newHandle;
+}
+
+float SeekableHandles::GetFrame(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = handles_.find(handle);
+	if (it == handles_.end())
+	{
+		return -1.0f;
+	}
+	return it->second.Frame;
+}
+
+void SeekableHandles::Sweep(Effekseer::Manager* manager)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	std::vector<int32_t> removed;
+	for (const auto& pair : handles_)
+	{
+		if (!manager->Exists(pair.first))
+		{
+			removed.push_back(pair.first);
+		}
+	}
+
+	for (auto handle : removed)
+	{
+		RemoveWithoutLock(handle);
+	}
+}
+
+} // namespace EffekseerPlugin
+
+using namespace EffekseerPlugin;
+
+extern "C"
+{
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerPlaySeekableEffect(Effekseer::Effect* effect, float x, float y, float z, float frame)
+	{
+		auto seekable = SeekableHandles::GetInstance();
+		if (g_EffekseerManager == nullptr || seekable == nullptr || effect == nullptr)
+		{
+			return -1;
+		}
+
+		return seekable->Play(g_EffekseerManager, effect, Effekseer::Vector3D(x, y, z), frame);
+	}
+
+	UNITY_INTERFACE_EXPORT int UNITY_INTERFACE_API EffekseerSeekHandle(int handle, float frame)
+	{
+		auto seekable = SeekableHandles::GetInstance();
+		if (g_EffekseerManager == nullptr || seekable == nullptr)
+		{
+			return handle;
+		}
+
+		return seekable->Seek(g_EffekseerManager, handle, frame);
+	}
+
+	UNITY_INTERFACE_EXPORT float UNITY_INTERFACE_API EffekseerGetHandleFrame(int handle)
+	{
+		auto seekable = SeekableHandles::GetInstance();
+		if (seekable == nullptr)
+		{
+			return -1.0f;
+		}
+
+		return seekable->GetFrame(handle);
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../unity/IUnityInterface.h"
+#include "EffekseerPluginCommon.h"
+
+#ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
+#include <Effekseer/Effekseer.h>
+#else
+#include <Effekseer.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace EffekseerPlugin
+{
+
+/**
+	@brief	handles which can be moved to any frame
+	@note
+	A state of a handle cannot be saved, so the current state of a handle is the only checkpoint.
+	A forward seek updates the handle in one call and a backward seek plays the effect again from the frame.
+*/
+class SeekableHandles
+{
+private:
+	struct HandleState
+	{
+		Effekseer::Effect* Effect = nullptr;
+		float Frame = 0.0f;
+	};
+
+	std::mutex mtx_;
+	std::unordered_map<int32_t, HandleState> handles_;
+
+	static std::shared_ptr<SeekableHandles> instance_;
+
+	void RemoveWithoutLock(int32_t handle);
+
+public:
+	static void Initialize();
+
+	static void Terminate();
+
+	static std::shared_ptr<SeekableHandles> GetInstance();
+
+	~SeekableHandles();
+
+	Effekseer::Handle Play(Effekseer::Manager* manager, Effekseer::Effect* effect, const Effekseer::Vector3D& position, float frame);
+
+	//! return a new handle if the effect is played again
+	Effekseer::Handle Seek(Effekseer::Manager* manager, int32_t handle, float frame);
+
+	//! return a negative value if the handle is not seekable
+	float GetFrame(int32_t handle);
+
+	//! release handles which have been removed from a manager
+	void Sweep(Effekseer::Manager* manager);
+};
+
+} // namespace EffekseerPlugin
@@ -1,50 +1,44 @@
-#include <algorithm>
 #include "EffekseerPluginSound.h"
 
 namespace EffekseerPlugin
 {
+	SoundLoader::SoundLoader(
+		SoundLoaderLoad load,
+		SoundLoaderUnload unload)
+		: load(load), unload(unload)
+	{
+		resources.SetReleaseCallback([this](const std::u16string& path, uintptr_t soundID) {
+			this->unload( path.c_str() );
+		});
+	}
+
 	void* SoundLoader::Load( const EFK_CHAR* path ){
 		// \[Xe[uđ݂炻g
-		auto it = resources.find((const char16_t*)path);
-		if (it != resources.end()) {
-			it->second.referenceCount++;
-			return (void*)it->second.soundID;
+		uintptr_t soundID = 0;
+		if (resources.Acquire((const char16_t*)path, soundID)) {
+			return (void*)soundID;
 		}
 
 		// UnityŃ[h
-		SoundResource res;
-		res.soundID = load( (const char16_t*)path );
-		if (res.soundID == 0) {
+		soundID = load( (const char16_t*)path );
+		if (soundID == 0) {
+			resources.Cancel((const char16_t*)path);
 			return 0;
 		}
 		
 		// \[Xe[uɒǉ
-		resources.insert( std::make_pair((const char16_t*)path, res ) );
+		resources.Add((const char16_t*)path, soundID);
 		
-		return (void*)res.soundID;
+		return (void*)soundID;
 	}
 
 	void SoundLoader::Unload( void* source ){
 		if (source == nullptr) {
 			return;
 		}
-		uintptr_t soundID = (uintptr_t)source;
-
-		// A[h郂f
-		auto it = std::find_if(resources.begin(), resources.end(), 
-			[soundID](const std::pair<std::u16string, SoundResource>& pair){
-				return pair.second.soundID == soundID;
-			});
-		if (it == resources.end()) {
-			return;
-		}
 
 		// QƃJE^0ɂȂۂɃA[h
-		it->second.referenceCount--;
-		if (it->second.referenceCount <= 0) {
-			unload( it->first.c_str() );
-			resources.erase(it);
-		}
+		resources.Release((uintptr_t)source);
 	}
 	
 	SoundLoader* SoundLoader::Create(
@@ -54,6 +48,8 @@ namespace EffekseerPlugin
 		return new SoundLoader(load, unload);
 	}
 
+	bool SoundPlayer::isMuted = false;
+
 	SoundPlayer* SoundPlayer::Create(
 		SoundPlayerPlay play,
 		SoundPlayerStopTag stopTag,
@@ -3,7 +3,6 @@
 #define __EFFEKSEER_PLUGIN_SOUND_H__
 
 #include <string>
-#include <map>
 
 #ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
 #include <Effekseer/Effekseer.h>
@@ -12,6 +11,7 @@
 #endif
 
 #include "EffekseerPluginCommon.h"
+#include "EffekseerPluginResourceRegistry.h"
 #include "../unity/IUnityInterface.h"
 
 namespace EffekseerPlugin
@@ -27,11 +27,7 @@ namespace EffekseerPlugin
 		SoundLoaderLoad load;
 		SoundLoaderUnload unload;
 		
-		struct SoundResource {
-			int referenceCount = 1;
-			uintptr_t soundID = 0;
-		};
-		std::map<std::u16string, SoundResource> resources;
+		ResourceRegistry<uintptr_t> resources;
 
 	public:
 		static SoundLoader* Create(
@@ -39,8 +35,7 @@ namespace EffekseerPlugin
 			SoundLoaderUnload unload);
 		SoundLoader(
 			SoundLoaderLoad load,
-			SoundLoaderUnload unload) 
-			: load(load), unload(unload) {}
+			SoundLoaderUnload unload);
 		virtual ~SoundLoader() {}
 		virtual void* Load( const EFK_CHAR* path );
 		virtual void Unload( void* source );
@@ -61,8 +56,12 @@ namespace EffekseerPlugin
 		SoundPlayerPauseTag pauseTag;
 		SoundPlayerCheckPlayingTag checkPlayingTag;
 		SoundPlayerStopAll stopAll;
+		static bool isMuted;
 	
 	public:
+		//! sounds are not played while muted. used when effects are played internally
+		static void SetMuted(bool muted) { isMuted = muted; }
+
 		static SoundPlayer* Create(
 			SoundPlayerPlay play,
 			SoundPlayerStopTag stopTag,
@@ -79,6 +78,9 @@ namespace EffekseerPlugin
 			checkPlayingTag(checkPlayingTag), stopAll(stopAll) {}
 		virtual ~SoundPlayer() {}
 		virtual SoundHandle Play( SoundTag tag, const InstanceParameter& parameter ){
+			if (isMuted) {
+				return 0;
+			}
 			play( tag, (uintptr_t)parameter.Data, parameter.Volume, parameter.Pan, parameter.Pitch, 
 				parameter.Mode3D, parameter.Position.X, parameter.Position.Y, 
 				parameter.Position.Z, parameter.Distance );
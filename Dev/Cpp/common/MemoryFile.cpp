@@ -1,4 +1,5 @@
 ﻿#include "MemoryFile.h"
+#include "EffekseerPluginCompression.h"
 
 namespace EffekseerPlugin
 {
@@ -22,11 +23,93 @@ int MemoryFileReader::GetPosition() { return position_; }
 
 size_t MemoryFileReader::GetLength() { return length_; }
 
-MemoryFile::MemoryFile(size_t bufferSize) { LoadedBuffer.resize(bufferSize); }
+MemoryBufferPool::Lease::Lease(MemoryBufferPool& pool) : pool_(pool), buffer_(pool.Rent()) {}
 
-void MemoryFile::Resize(size_t bufferSize) { LoadedBuffer.resize(bufferSize); }
+MemoryBufferPool::Lease::~Lease() { pool_.Return(std::move(buffer_)); }
 
-Effekseer::FileReader* MemoryFile::OpenRead(const EFK_CHAR* path) { return new MemoryFileReader(&LoadedBuffer[0], LoadedSize); }
+MemoryBufferPool::MemoryBufferPool(size_t initialSize, size_t maxPooledCount)
+	: initialSize_(initialSize), maxPooledCount_(maxPooledCount)
+{
+}
+
+std::unique_ptr<MemoryBufferPool::Buffer> MemoryBufferPool::Rent()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		if (!buffers_.empty())
+		{
+			auto buffer = std::move(buffers_.back());
+			buffers_.pop_back();
+			return buffer;
+		}
+	}
+
+	auto buffer = std::unique_ptr<Buffer>(new Buffer());
+	buffer->resize(initialSize_);
+	return buffer;
+}
+
+void MemoryBufferPool::Return(std::unique_ptr<Buffer> buffer)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	if (buffers_.size() < maxPooledCount_)
+	{
+		buffers_.emplace_back(std::move(buffer));
+	}
+}
+
+bool DecompressIfCompressed(const uint8_t*& data, size_t& size, MemoryBufferPool::Buffer& buffer)
+{
+	if (!Compression::IsCompressed(data, size))
+	{
+		return true;
+	}
+
+	// a size is validated before it is allocated
+	const auto decompressedSize = Compression::GetDecompressedSize(data, size);
+	if (decompressedSize == 0)
+	{
+		return false;
+	}
+
+	// decompress directly into a buffer without intermediate copies
+	buffer.resize(decompressedSize);
+	if (!Compression::Decompress(data, size, buffer.data(), buffer.size()))
+	{
+		buffer.clear();
+		return false;
+	}
+
+	data = buffer.data();
+	size = buffer.size();
+	return true;
+}
+
+void MemoryFile::Bind(uint8_t* data, size_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	auto& bound = boundData_[std::this_thread::get_id()];
+	bound.Data = data;
+	bound.Size = size;
+}
+
+void MemoryFile::Unbind()
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+	boundData_.erase(std::this_thread::get_id());
+}
+
+Effekseer::FileReader* MemoryFile::OpenRead(const EFK_CHAR* path)
+{
+	std::lock_guard<std::mutex> lock(mtx_);
+
+	auto it = boundData_.find(std::this_thread::get_id());
+	if (it == boundData_.end())
+	{
+		return nullptr;
+	}
+	return new MemoryFileReader(it->second.Data, it->second.Size);
+}
 
 Effekseer::FileWriter* MemoryFile::OpenWrite(const EFK_CHAR* path) { return nullptr; }
 
@@ -12,11 +12,43 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace EffekseerPlugin
 {
 
+//! notify Unity that data which is lent by Unity is not read anymore
+using BorrowedDataGiveBack = void(UNITY_INTERFACE_API*)(const char16_t* path);
+
+/**
+	@brief	data which is owned and pinned by Unity while it is read
+	@note
+	The data is given back when it is destroyed.
+*/
+class BorrowedData
+{
+	const char16_t* path_ = nullptr;
+	BorrowedDataGiveBack giveBack_ = nullptr;
+
+public:
+	BorrowedData(const char16_t* path, BorrowedDataGiveBack giveBack) : path_(path), giveBack_(giveBack) {}
+
+	~BorrowedData()
+	{
+		if (giveBack_ != nullptr)
+		{
+			giveBack_(path_);
+		}
+	}
+
+	BorrowedData(const BorrowedData&) = delete;
+	BorrowedData& operator=(const BorrowedData&) = delete;
+};
+
 class MemoryFileReader : public Effekseer::FileReader
 {
 	uint8_t* data_ = nullptr;
@@ -31,13 +63,76 @@ public:
 	size_t GetLength();
 };
 
+/**
+	@brief	scratch buffers which are lent to each call of loaders
+	@note
+	Loaders can be called from several threads, so a buffer is not shared between calls.
+	Returned buffers keep their capacity and are reused by next calls.
+*/
+class MemoryBufferPool
+{
+public:
+	using Buffer = Effekseer::CustomVector<uint8_t>;
+
+	//! a buffer which is returned to a pool when it is destroyed
+	class Lease
+	{
+		MemoryBufferPool& pool_;
+		std::unique_ptr<Buffer> buffer_;
+
+	public:
+		explicit Lease(MemoryBufferPool& pool);
+		~Lease();
+		Lease(const Lease&) = delete;
+		Lease& operator=(const Lease&) = delete;
+
+		uint8_t* GetData() { return buffer_->data(); }
+		size_t GetSize() const { return buffer_->size(); }
+		void Resize(size_t size) { buffer_->resize(size); }
+		Buffer& Get() { return *buffer_; }
+	};
+
+private:
+	std::mutex mtx_;
+	std::vector<std::unique_ptr<Buffer>> buffers_;
+	size_t initialSize_ = 0;
+	size_t maxPooledCount_ = 0;
+
+	std::unique_ptr<Buffer> Rent();
+	void Return(std::unique_ptr<Buffer> buffer);
+
+public:
+	MemoryBufferPool(size_t initialSize, size_t maxPooledCount = 4);
+};
+
+/**
+	@brief	decompress data into a buffer and point data to it if data is a compressed container
+	@return	false if a container is broken
+*/
+bool DecompressIfCompressed(const uint8_t*& data, size_t& size, MemoryBufferPool::Buffer& buffer);
+
+/**
+	@brief	a file interface which reads data bound by a calling thread
+	@note
+	Each thread binds its own data, so internal loaders can read on several threads at once.
+*/
 class MemoryFile : public Effekseer::FileInterface
 {
+	struct BoundData
+	{
+		uint8_t* Data = nullptr;
+		size_t Size = 0;
+	};
+
+	std::mutex mtx_;
+	std::unordered_map<std::thread::id, BoundData> boundData_;
+
 public:
-	Effekseer::CustomVector<uint8_t> LoadedBuffer;
-	size_t LoadedSize = 0;
-	explicit MemoryFile(size_t bufferSize);
-	void Resize(size_t bufferSize);
+	MemoryFile() = default;
+
+	//! read data with OpenRead on the calling thread until Unbind
+	void Bind(uint8_t* data, size_t size);
+	void Unbind();
 	Effekseer::FileReader* OpenRead(const EFK_CHAR* path);
 	Effekseer::FileWriter* OpenWrite(const EFK_CHAR* path);
 };
@@ -71,6 +71,20 @@ public:
 	virtual void WaitFinish() {}
 
 	virtual bool IsRequiredToFlipVerticallyWhenRenderToTexture() const { return true; }
+
+	//! whether drawn geometry can be duplicated with transforms by BeginInstancedDrawing and EndInstancedDrawing
+	virtual bool IsInstancedDrawingSupported() const { return false; }
+
+	//! return a marker which is passed to EndInstancedDrawing
+	virtual int32_t BeginInstancedDrawing(EffekseerRenderer::Renderer* renderer) { return -1; }
+
+	//! duplicate geometry drawn after BeginInstancedDrawing for each transform. built geometry is scaled around origin without rotation
+	virtual void EndInstancedDrawing(EffekseerRenderer::Renderer* renderer,
+									 int32_t marker,
+									 const std::vector<Effekseer::Matrix44>& transforms,
+									 const Effekseer::Vector3D& origin)
+	{
+	}
 };
 
 } // namespace EffekseerPlugin
@@ -3,8 +3,9 @@
 #include "../unity/IUnityGraphics.h"
 #include "../unity/IUnityGraphicsD3D11.h"
 #include "../unity/IUnityInterface.h"
-#include <algorithm>
+#include "../common/EffekseerPluginResourceRegistry.h"
 #include <assert.h>
+#include <mutex>
 
 // TODO is default OK?
 #pragma comment(lib, "d3dcompiler.lib")
@@ -14,14 +15,9 @@ namespace EffekseerPlugin
 
 class TextureLoaderDX11 : public TextureLoader
 {
-	struct TextureResource
-	{
-		int referenceCount = 1;
-		Effekseer::TextureData* textureDataPtr = nullptr;
-	};
-
-	std::map<std::u16string, TextureResource> resources;
-	std::map<void*, void*> textureData2NativePtr;
+	ResourceRegistry<Effekseer::TextureData*> resources;
+	std::unordered_map<void*, void*> textureData2NativePtr;
+	std::mutex textureData2NativePtrMutex;
 
 	ID3D11Device* d3d11Device = nullptr;
 
@@ -30,6 +26,22 @@ public:
 		: TextureLoader(load, unload), d3d11Device(device)
 	{
 		ES_SAFE_ADDREF(device);
+
+		resources.SetReleaseCallback([this](const std::u16string& path, Effekseer::TextureData* textureData) {
+			// 作成したID3D11ShaderResourceViewを解放する
+			ID3D11ShaderResourceView* srv = (ID3D11ShaderResourceView*)textureData->UserPtr;
+			srv->Release();
+
+			// Unload from unity
+			void* texturePtr = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+				texturePtr = textureData2NativePtr[textureData];
+				textureData2NativePtr.erase(textureData);
+			}
+			this->unload(path.c_str(), texturePtr);
+			ES_SAFE_DELETE(textureData);
+		});
 	}
 
 	virtual ~TextureLoaderDX11() { ES_SAFE_RELEASE(d3d11Device); }
@@ -37,11 +49,10 @@ public:
 	virtual Effekseer::TextureData* Load(const EFK_CHAR* path, Effekseer::TextureType textureType)
 	{
 		// リソーステーブルを検索して存在したらそれを使う
-		auto it = resources.find((const char16_t*)path);
-		if (it != resources.end())
+		Effekseer::TextureData* textureData = nullptr;
+		if (resources.Acquire((const char16_t*)path, textureData))
 		{
-			it->second.referenceCount++;
-			return it->second.textureDataPtr;
+			return textureData;
 		}
 
 		// Unityでテクスチャをロード
@@ -49,16 +60,14 @@ public:
 		void* texturePtr = load((const char16_t*)path, &width, &height, &format);
 		if (texturePtr == nullptr)
 		{
+			resources.Cancel((const char16_t*)path);
 			return nullptr;
 		}
 
-		// リソーステーブルに追加
-		auto added = resources.insert(std::make_pair((const char16_t*)path, TextureResource()));
-		TextureResource& res = added.first->second;
-		res.textureDataPtr = new Effekseer::TextureData();
-		res.textureDataPtr->Width = width;
-		res.textureDataPtr->Height = height;
-		res.textureDataPtr->TextureFormat = (Effekseer::TextureFormatType)format;
+		textureData = new Effekseer::TextureData();
+		textureData->Width = width;
+		textureData->Height = height;
+		textureData->TextureFormat = (Effekseer::TextureFormatType)format;
 
 		// DX11の場合、UnityがロードするのはID3D11Texture2Dなので、
 		// ID3D11ShaderResourceViewを作成する
@@ -78,14 +87,22 @@ public:
 		hr = d3d11Device->CreateShaderResourceView(textureDX11, &desc, &srv);
 		if (FAILED(hr))
 		{
+			ES_SAFE_DELETE(textureData);
+			resources.Cancel((const char16_t*)path);
 			return nullptr;
 		}
 
-		res.textureDataPtr->UserPtr = srv;
+		textureData->UserPtr = srv;
+
+		{
+			std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+			textureData2NativePtr[textureData] = texturePtr;
+		}
 
-		textureData2NativePtr[res.textureDataPtr] = texturePtr;
+		// リソーステーブルに追加
+		resources.Add((const char16_t*)path, textureData);
 
-		return res.textureDataPtr;
+		return textureData;
 	}
 
 	virtual void Unload(Effekseer::TextureData* source)
@@ -95,30 +112,8 @@ public:
 			return;
 		}
 
-		// アンロードするテクスチャを検索
-		auto it = std::find_if(resources.begin(), resources.end(), [source](const std::pair<std::u16string, TextureResource>& pair) {
-			return pair.second.textureDataPtr->UserPtr == source->UserPtr;
-		});
-		if (it == resources.end())
-		{
-			return;
-		}
-
 		// 参照カウンタが0になったら実際にアンロード
-		it->second.referenceCount--;
-		if (it->second.referenceCount <= 0)
-		{
-
-			// 作成したID3D11ShaderResourceViewを解放する
-			ID3D11ShaderResourceView* srv = (ID3D11ShaderResourceView*)source->UserPtr;
-			srv->Release();
-
-			// Unload from unity
-			unload(it->first.c_str(), textureData2NativePtr[source]);
-			textureData2NativePtr.erase(source);
-			ES_SAFE_DELETE(it->second.textureDataPtr);
-			resources.erase(it);
-		}
+		resources.Release(source);
 	}
 };
 
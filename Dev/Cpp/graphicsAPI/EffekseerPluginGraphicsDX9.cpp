@@ -1,33 +1,42 @@
 ﻿
 #include "EffekseerPluginGraphicsDX9.h"
 #include "../unity/IUnityGraphicsD3D9.h"
-#include <algorithm>
+#include "../common/EffekseerPluginResourceRegistry.h"
 #include <assert.h>
+#include <mutex>
 
 namespace EffekseerPlugin
 {
 
 class TextureLoaderDX9 : public TextureLoader
 {
-	struct TextureResource
-	{
-		int referenceCount = 1;
-		Effekseer::TextureData* textureDataPtr = nullptr;
-	};
-	std::map<std::u16string, TextureResource> resources;
-	std::map<void*, void*> textureData2NativePtr;
+	ResourceRegistry<Effekseer::TextureData*> resources;
+	std::unordered_map<void*, void*> textureData2NativePtr;
+	std::mutex textureData2NativePtrMutex;
 
 public:
-	TextureLoaderDX9(TextureLoaderLoad load, TextureLoaderUnload unload) : TextureLoader(load, unload) {}
+	TextureLoaderDX9(TextureLoaderLoad load, TextureLoaderUnload unload) : TextureLoader(load, unload)
+	{
+		resources.SetReleaseCallback([this](const std::u16string& path, Effekseer::TextureData* textureData) {
+			// Unload from unity
+			void* texturePtr = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+				texturePtr = textureData2NativePtr[textureData];
+				textureData2NativePtr.erase(textureData);
+			}
+			this->unload(path.c_str(), texturePtr);
+			ES_SAFE_DELETE(textureData);
+		});
+	}
 	virtual ~TextureLoaderDX9() {}
 	virtual Effekseer::TextureData* Load(const EFK_CHAR* path, Effekseer::TextureType textureType)
 	{
 		// リソーステーブルを検索して存在したらそれを使う
-		auto it = resources.find((const char16_t*)path);
-		if (it != resources.end())
+		Effekseer::TextureData* textureData = nullptr;
+		if (resources.Acquire((const char16_t*)path, textureData))
 		{
-			it->second.referenceCount++;
-			return it->second.textureDataPtr;
+			return textureData;
 		}
 
 		// Unityでテクスチャをロード
@@ -35,23 +44,27 @@ public:
 		void* texturePtr = load((const char16_t*)path, &width, &height, &format);
 		if (texturePtr == nullptr)
 		{
+			resources.Cancel((const char16_t*)path);
 			return nullptr;
 		}
 
-		// リソーステーブルに追加
-		auto added = resources.insert(std::make_pair((const char16_t*)path, TextureResource()));
-		TextureResource& res = added.first->second;
-		res.textureDataPtr = new Effekseer::TextureData();
-		res.textureDataPtr->Width = width;
-		res.textureDataPtr->Height = height;
-		res.textureDataPtr->TextureFormat = (Effekseer::TextureFormatType)format;
+		textureData = new Effekseer::TextureData();
+		textureData->Width = width;
+		textureData->Height = height;
+		textureData->TextureFormat = (Effekseer::TextureFormatType)format;
 
 		IDirect3DTexture9* textureDX9 = (IDirect3DTexture9*)texturePtr;
-		res.textureDataPtr->UserPtr = textureDX9;
+		textureData->UserPtr = textureDX9;
+
+		{
+			std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+			textureData2NativePtr[textureData] = texturePtr;
+		}
 
-		textureData2NativePtr[res.textureDataPtr] = texturePtr;
+		// リソーステーブルに追加
+		resources.Add((const char16_t*)path, textureData);
 
-		return res.textureDataPtr;
+		return textureData;
 	}
 	virtual void Unload(Effekseer::TextureData* source)
 	{
@@ -60,25 +73,8 @@ public:
 			return;
 		}
 
-		// アンロードするテクスチャを検索
-		auto it = std::find_if(resources.begin(), resources.end(), [source](const std::pair<std::u16string, TextureResource>& pair) {
-			return pair.second.textureDataPtr->UserPtr == source->UserPtr;
-		});
-		if (it == resources.end())
-		{
-			return;
-		}
-
 		// 参照カウンタが0になったら実際にアンロード
-		it->second.referenceCount--;
-		if (it->second.referenceCount <= 0)
-		{
-			// Unload from unity
-			unload(it->first.c_str(), textureData2NativePtr[source]);
-			textureData2NativePtr.erase(source);
-			ES_SAFE_DELETE(it->second.textureDataPtr);
-			resources.erase(it);
-		}
+		resources.Release(source);
 	}
 };
 
@@ -1,7 +1,7 @@
 ﻿
 #include "EffekseerPluginGraphicsGL.h"
-#include <algorithm>
 #include <assert.h>
+#include <mutex>
 
 #ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
 #else
@@ -10,20 +10,16 @@
 #endif
 
 #include "../common/EffekseerPluginMaterial.h"
+#include "../common/EffekseerPluginResourceRegistry.h"
 
 namespace EffekseerPlugin
 {
 
 class TextureLoaderGL : public TextureLoader
 {
-	struct TextureResource
-	{
-		int referenceCount = 1;
-		Effekseer::TextureData* textureDataPtr = nullptr;
-	};
-
-	std::map<std::u16string, TextureResource> resources;
-	std::map<void*, void*> textureData2NativePtr;
+	ResourceRegistry<Effekseer::TextureData*> resources;
+	std::unordered_map<void*, void*> textureData2NativePtr;
+	std::mutex textureData2NativePtrMutex;
 	UnityGfxRenderer gfxRenderer;
 
 public:
@@ -41,6 +37,17 @@ bool IsPowerOfTwo(uint32_t x) { return (x & (x - 1)) == 0; }
 TextureLoaderGL::TextureLoaderGL(TextureLoaderLoad load, TextureLoaderUnload unload, UnityGfxRenderer renderer)
 	: TextureLoader(load, unload), gfxRenderer(renderer)
 {
+	resources.SetReleaseCallback([this](const std::u16string& path, Effekseer::TextureData* textureData) {
+		// Unity側でアンロード
+		void* texturePtr = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+			texturePtr = textureData2NativePtr[textureData];
+			textureData2NativePtr.erase(textureData);
+		}
+		this->unload(path.c_str(), texturePtr);
+		ES_SAFE_DELETE(textureData);
+	});
 }
 
 TextureLoaderGL::~TextureLoaderGL() {}
@@ -48,11 +55,10 @@ TextureLoaderGL::~TextureLoaderGL() {}
 Effekseer::TextureData* TextureLoaderGL::Load(const EFK_CHAR* path, Effekseer::TextureType textureType)
 {
 	// リソーステーブルを検索して存在したらそれを使う
-	auto it = resources.find((const char16_t*)path);
-	if (it != resources.end())
+	Effekseer::TextureData* textureData = nullptr;
+	if (resources.Acquire((const char16_t*)path, textureData))
 	{
-		it->second.referenceCount++;
-		return it->second.textureDataPtr;
+		return textureData;
 	}
 
 	// Unityでテクスチャをロード
@@ -60,19 +66,18 @@ Effekseer::TextureData* TextureLoaderGL::Load(const EFK_CHAR* path, Effekseer::T
 	int64_t textureID = reinterpret_cast<int64_t>(load((const char16_t*)path, &width, &height, &format));
 	if (textureID == 0)
 	{
+		resources.Cancel((const char16_t*)path);
 		return nullptr;
 	}
-	// リソーステーブルに追加
-	auto added = resources.insert(std::make_pair((const char16_t*)path, TextureResource()));
-	TextureResource& res = added.first->second;
-	res.textureDataPtr = new Effekseer::TextureData();
-	res.textureDataPtr->Width = width;
-	res.textureDataPtr->Height = height;
-	res.textureDataPtr->TextureFormat = (Effekseer::TextureFormatType)format;
-
-	res.textureDataPtr->UserID = textureID;
+
+	textureData = new Effekseer::TextureData();
+	textureData->Width = width;
+	textureData->Height = height;
+	textureData->TextureFormat = (Effekseer::TextureFormatType)format;
+
+	textureData->UserID = textureID;
 #if !defined(_WIN32)
-	if (gfxRenderer != kUnityGfxRendererOpenGLES20 || (IsPowerOfTwo(res.textureDataPtr->Width) && IsPowerOfTwo(res.textureDataPtr->Height)))
+	if (gfxRenderer != kUnityGfxRendererOpenGLES20 || (IsPowerOfTwo(textureData->Width) && IsPowerOfTwo(textureData->Height)))
 	{
 		// テクスチャのミップマップを生成する
 		glBindTexture(GL_TEXTURE_2D, (GLuint)textureID);
@@ -81,9 +86,15 @@ Effekseer::TextureData* TextureLoaderGL::Load(const EFK_CHAR* path, Effekseer::T
 	}
 #endif
 
-	textureData2NativePtr[res.textureDataPtr] = (void*)textureID;
+	{
+		std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+		textureData2NativePtr[textureData] = (void*)textureID;
+	}
 
-	return res.textureDataPtr;
+	// リソーステーブルに追加
+	resources.Add((const char16_t*)path, textureData);
+
+	return textureData;
 }
 
 void TextureLoaderGL::Unload(Effekseer::TextureData* source)
@@ -93,25 +104,8 @@ void TextureLoaderGL::Unload(Effekseer::TextureData* source)
 		return;
 	}
 
-	// アンロードするテクスチャを検索
-	auto it = std::find_if(resources.begin(), resources.end(), [source](const std::pair<std::u16string, TextureResource>& pair) {
-		return pair.second.textureDataPtr->UserID == source->UserID;
-	});
-	if (it == resources.end())
-	{
-		return;
-	}
-
 	// 参照カウンタが0になったら実際にアンロード
-	it->second.referenceCount--;
-	if (it->second.referenceCount <= 0)
-	{
-		// Unity側でアンロード
-		unload(it->first.c_str(), textureData2NativePtr[source]);
-		textureData2NativePtr.erase(source);
-		ES_SAFE_DELETE(it->second.textureDataPtr);
-		resources.erase(it);
-	}
+	resources.Release(source);
 }
 
 GraphicsGL::GraphicsGL(UnityGfxRenderer renderer) : gfxRenderer(renderer)
@@ -60,4 +60,17 @@ void GraphicsUnity::ShiftViewportForStereoSinglePass(bool isShift)
 {
 }
 
+int32_t GraphicsUnity::BeginInstancedDrawing(EffekseerRenderer::Renderer* renderer)
+{
+	return ((EffekseerRendererUnity::RendererImplemented*)renderer)->BeginInstancing();
+}
+
+void GraphicsUnity::EndInstancedDrawing(EffekseerRenderer::Renderer* renderer,
+										int32_t marker,
+										const std::vector<Effekseer::Matrix44>& transforms,
+										const Effekseer::Vector3D& origin)
+{
+	((EffekseerRendererUnity::RendererImplemented*)renderer)->EndInstancing(marker, transforms, origin);
+}
+
 } // namespace EffekseerPlugin
\ No newline at end of file
@@ -33,6 +33,15 @@ public:
 	Effekseer::MaterialLoader* Create(MaterialLoaderLoad load, MaterialLoaderUnload unload) override;
 
 	void ShiftViewportForStereoSinglePass(bool isShift) override;
+
+	bool IsInstancedDrawingSupported() const override { return true; }
+
+	int32_t BeginInstancedDrawing(EffekseerRenderer::Renderer* renderer) override;
+
+	void EndInstancedDrawing(EffekseerRenderer::Renderer* renderer,
+							 int32_t marker,
+							 const std::vector<Effekseer::Matrix44>& transforms,
+							 const Effekseer::Vector3D& origin) override;
 };
 
 } // namespace EffekseerPlugin
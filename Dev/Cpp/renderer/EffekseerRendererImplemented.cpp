@@ -3,6 +3,8 @@
 #include "EffekseerRendererRenderState.h"
 #include "EffekseerRendererShader.h"
 #include "EffekseerRendererVertexBuffer.h"
+#include <cmath>
+#include <cstddef>
 
 namespace EffekseerPlugin
 {
@@ -402,6 +404,188 @@ bool RendererImplemented::EndRendering()
 	return true;
 }
 
+static Effekseer::Vector3D TransformPosition(const Effekseer::Vector3D& v, const Effekseer::Matrix44& m)
+{
+	return Effekseer::Vector3D(v.X * m.Values[0][0] + v.Y * m.Values[1][0] + v.Z * m.Values[2][0] + m.Values[3][0],
+							   v.X * m.Values[0][1] + v.Y * m.Values[1][1] + v.Z * m.Values[2][1] + m.Values[3][1],
+							   v.X * m.Values[0][2] + v.Y * m.Values[1][2] + v.Z * m.Values[2][2] + m.Values[3][2]);
+}
+
+static Effekseer::Vector3D TransformDirection(const Effekseer::Vector3D& v, const Effekseer::Matrix44& m)
+{
+	Effekseer::Vector3D ret(v.X * m.Values[0][0] + v.Y * m.Values[1][0] + v.Z * m.Values[2][0],
+							v.X * m.Values[0][1] + v.Y * m.Values[1][1] + v.Z * m.Values[2][1],
+							v.X * m.Values[0][2] + v.Y * m.Values[1][2] + v.Z * m.Values[2][2]);
+
+	auto length = sqrtf(ret.X * ret.X + ret.Y * ret.Y + ret.Z * ret.Z);
+	if (length > 0.0f)
+	{
+		ret.X /= length;
+		ret.Y /= length;
+		ret.Z /= length;
+	}
+	return ret;
+}
+
+//! a transform which moves origin like transform and scales around it without rotation
+static Effekseer::Matrix44 RemoveRotation(const Effekseer::Matrix44& transform, const Effekseer::Vector3D& origin)
+{
+	float scales[3];
+	for (int32_t r = 0; r < 3; r++)
+	{
+		scales[r] = sqrtf(transform.Values[r][0] * transform.Values[r][0] + transform.Values[r][1] * transform.Values[r][1] +
+						  transform.Values[r][2] * transform.Values[r][2]);
+	}
+
+	const auto moved = TransformPosition(origin, transform);
+
+	Effekseer::Matrix44 ret;
+	for (int32_t r = 0; r < 4; r++)
+	{
+		for (int32_t c = 0; c < 4; c++)
+		{
+			ret.Values[r][c] = r == c ? (r < 3 ? scales[r] : 1.0f) : 0.0f;
+		}
+	}
+	ret.Values[3][0] = moved.X - origin.X * scales[0];
+	ret.Values[3][1] = moved.Y - origin.Y * scales[1];
+	ret.Values[3][2] = moved.Z - origin.Z * scales[2];
+	return ret;
+}
+
+int32_t RendererImplemented::BeginInstancing()
+{
+	m_standardRenderer->ResetAndRenderingIfRequired();
+	return static_cast<int32_t>(renderParameters.size());
+}
+
+void RendererImplemented::EndInstancing(int32_t firstParameter,
+										const std::vector<Effekseer::Matrix44>& transforms,
+										const Effekseer::Vector3D& origin)
+{
+	m_standardRenderer->ResetAndRenderingIfRequired();
+
+	if (transforms.empty())
+	{
+		renderParameters.resize(firstParameter);
+		return;
+	}
+
+	const auto lastParameter = static_cast<int32_t>(renderParameters.size());
+
+	// copies must be made before the first instance transforms exported data in place
+	for (size_t i = 1; i < transforms.size(); i++)
+	{
+		for (int32_t pi = firstParameter; pi < lastParameter; pi++)
+		{
+			auto rp = renderParameters[pi];
+			rp.VertexBufferOffset = CopyExportedData(rp);
+			TransformExportedData(rp, transforms[i], origin);
+			renderParameters.push_back(rp);
+		}
+	}
+
+	for (int32_t pi = firstParameter; pi < lastParameter; pi++)
+	{
+		TransformExportedData(renderParameters[pi], transforms[0], origin);
+	}
+}
+
+void RendererImplemented::AppendExportedData(const std::vector<UnityRenderParameter>& parameters,
+											 const std::vector<uint8_t>& vertexBuffer,
+											 const std::vector<uint8_t>& infoBuffer)
+{
+	const auto infoOffset = AddInfoBuffer(infoBuffer.data(), static_cast<int32_t>(infoBuffer.size()));
+
+	for (auto rp : parameters)
+	{
+		if (rp.RenderMode == 0)
+		{
+			AlignVertexBuffer(rp.VertexBufferStride);
+			rp.VertexBufferOffset = AddVertexBuffer(vertexBuffer.data() + rp.VertexBufferOffset, rp.ElementCount * 4 * rp.VertexBufferStride);
+		}
+		else
+		{
+			rp.VertexBufferOffset += infoOffset;
+		}
+
+		if (rp.MaterialType == Effekseer::RendererMaterialType::File)
+		{
+			rp.UniformBufferOffset += infoOffset;
+			rp.CustomData1BufferOffset += infoOffset;
+			rp.CustomData2BufferOffset += infoOffset;
+		}
+
+		renderParameters.push_back(rp);
+	}
+}
+
+int32_t RendererImplemented::GetModelParameterSize() { return static_cast<int32_t>(sizeof(UnityModelParameter)); }
+
+int32_t RendererImplemented::CopyExportedData(const UnityRenderParameter& rp)
+{
+	if (rp.RenderMode == 0)
+	{
+		const auto size = rp.ElementCount * 4 * rp.VertexBufferStride;
+		std::vector<uint8_t> data(exportedVertexBuffer.begin() + rp.VertexBufferOffset,
+								  exportedVertexBuffer.begin() + rp.VertexBufferOffset + size);
+		AlignVertexBuffer(rp.VertexBufferStride);
+		return AddVertexBuffer(data.data(), size);
+	}
+
+	const auto size = rp.ElementCount * static_cast<int32_t>(sizeof(UnityModelParameter));
+	std::vector<uint8_t> data(exportedInfoBuffer.begin() + rp.VertexBufferOffset, exportedInfoBuffer.begin() + rp.VertexBufferOffset + size);
+	return AddInfoBuffer(data.data(), size);
+}
+
+void RendererImplemented::TransformExportedData(const UnityRenderParameter& rp,
+												const Effekseer::Matrix44& transform,
+												const Effekseer::Vector3D& origin)
+{
+	if (rp.RenderMode == 0)
+	{
+		const auto geometryTransform = RemoveRotation(transform, origin);
+
+		int32_t directionOffsets[2] = {-1, -1};
+
+		if (rp.MaterialType == Effekseer::RendererMaterialType::BackDistortion)
+		{
+			directionOffsets[0] = offsetof(UnityDistortionVertex, Tangent);
+			directionOffsets[1] = offsetof(UnityDistortionVertex, Binormal);
+		}
+		else if (rp.MaterialType == Effekseer::RendererMaterialType::Lighting ||
+				 rp.MaterialType == Effekseer::RendererMaterialType::File)
+		{
+			directionOffsets[0] = offsetof(UnityDynamicVertex, Normal);
+			directionOffsets[1] = offsetof(UnityDynamicVertex, Tangent);
+		}
+
+		// a position is the first element of all vertex types
+		auto vertex = exportedVertexBuffer.data() + rp.VertexBufferOffset;
+		for (int32_t vi = 0; vi < rp.ElementCount * 4; vi++, vertex += rp.VertexBufferStride)
+		{
+			auto pos = reinterpret_cast<Effekseer::Vector3D*>(vertex);
+			*pos = TransformPosition(*pos, geometryTransform);
+
+			for (auto offset : directionOffsets)
+			{
+				if (offset >= 0)
+				{
+					auto dir = reinterpret_cast<Effekseer::Vector3D*>(vertex + offset);
+					*dir = TransformDirection(*dir, geometryTransform);
+				}
+			}
+		}
+		return;
+	}
+
+	auto parameters = reinterpret_cast<UnityModelParameter*>(exportedInfoBuffer.data() + rp.VertexBufferOffset);
+	for (int32_t i = 0; i < rp.ElementCount; i++)
+	{
+		Effekseer::Matrix44::Mul(parameters[i].Matrix, parameters[i].Matrix, transform);
+	}
+}
+
 int32_t RendererImplemented::GetSquareMaxCount() const { return m_squareMaxCount; }
 
 ::Effekseer::SpriteRenderer* RendererImplemented::CreateSpriteRenderer()
@@ -164,6 +164,16 @@ protected:
 	int32_t AddInfoBuffer(const void* data, int32_t size);
 	void AlignVertexBuffer(int32_t alignment);
 
+	int32_t CopyExportedData(const UnityRenderParameter& rp);
+
+	/**
+		@brief	transform models entirely, and translate and scale built geometry without rotating it
+		@note
+		Exported data does not tell billboards from fixed sprites and ribbons,
+		so built geometry is never rotated and billboards keep facing the camera.
+	*/
+	void TransformExportedData(const UnityRenderParameter& rp, const Effekseer::Matrix44& transform, const Effekseer::Vector3D& origin);
+
 
 public:
 	static RendererImplemented* Create();
@@ -298,6 +308,24 @@ public:
 	std::vector<uint8_t>& GetRenderVertexBuffer() { return exportedVertexBuffer; }
 	std::vector<uint8_t>& GetRenderInfoBuffer() { return exportedInfoBuffer; }
 
+	//! flush pending sprites and return the index of the next render parameter
+	int32_t BeginInstancing();
+
+	//! duplicate render parameters after firstParameter for each transform. built geometry is scaled around origin
+	void EndInstancing(int32_t firstParameter,
+					   const std::vector<Effekseer::Matrix44>& transforms,
+					   const Effekseer::Vector3D& origin = Effekseer::Vector3D());
+
+	//! append exported data which was captured from this renderer
+	void AppendExportedData(const std::vector<UnityRenderParameter>& parameters,
+							const std::vector<uint8_t>& vertexBuffer,
+							const std::vector<uint8_t>& infoBuffer);
+
+	//! the size of a parameter of an instance of a model in an info buffer
+	static int32_t GetModelParameterSize();
+
+	void* GetBackground() const { return backgroundData.UserPtr; }
+
 	virtual int GetRef() { return ::Effekseer::ReferenceObject::GetRef(); }
 	virtual int AddRef() { return ::Effekseer::ReferenceObject::AddRef(); }
 	virtual int Release() { return ::Effekseer::ReferenceObject::Release(); }
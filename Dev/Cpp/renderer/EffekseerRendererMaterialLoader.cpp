@@ -1,29 +1,99 @@
 #include "EffekseerRendererMaterialLoader.h"
 #include "EffekseerRendererImplemented.h"
 #include "EffekseerRendererShader.h"
+#include "../common/EffekseerPluginCompression.h"
 #include <algorithm>
 
 namespace EffekseerRendererUnity
 {
 
 MaterialLoader::MaterialLoader(EffekseerPlugin::MaterialLoaderLoad load, EffekseerPlugin::MaterialLoaderUnload unload)
-	: load_(load), unload_(unload), memoryFile_(1 * 1024 * 1024), memoryFileForCache_(1 * 1024 * 1024)
+	: load_(load), unload_(unload), buffers_(1 * 1024 * 1024)
 {
+	resources.SetReleaseCallback([this](const std::u16string& path, Effekseer::MaterialData* materialData) {
+		auto ss = static_cast<Shader*>(materialData->UserPtr);
+		auto sm = static_cast<Shader*>(materialData->ModelUserPtr);
+		auto srs = static_cast<Shader*>(materialData->RefractionUserPtr);
+		auto srm = static_cast<Shader*>(materialData->RefractionModelUserPtr);
+
+		void* ptr = nullptr;
+		if (ss != nullptr)
+		{
+			ptr = ss->GetUnityMaterial();
+		}
+
+		ES_SAFE_DELETE(ss);
+		ES_SAFE_DELETE(sm);
+		ES_SAFE_DELETE(srs);
+		ES_SAFE_DELETE(srm);
+		ES_SAFE_DELETE(materialData);
+
+		unload_(path.c_str(), ptr);
+	});
 }
 
 MaterialLoader::~MaterialLoader() {}
 
 Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 {
-	auto it = resources.find((const char16_t*)path);
-	if (it != resources.end())
+	Effekseer::MaterialData* internalData = nullptr;
+	if (resources.Acquire((const char16_t*)path, internalData))
+	{
+		return internalData;
+	}
+
+	auto event = EffekseerPlugin::MaterialLoader::GetBorrowEvent();
+	if (event.Borrow != nullptr)
+	{
+		internalData = LoadBorrowed(path, event);
+	}
+	else
 	{
-		it->second.referenceCount++;
-		return it->second.internalData;
+		internalData = LoadCopied(path);
 	}
 
+	if (internalData == nullptr)
+	{
+		resources.Cancel((const char16_t*)path);
+		return nullptr;
+	}
+
+	resources.Add((const char16_t*)path, internalData);
+	return internalData;
+}
+
+Effekseer::MaterialData* MaterialLoader::LoadBorrowed(const EFK_CHAR* path, const EffekseerPlugin::MaterialLoaderBorrowEvent& event)
+{
+	// Unity keeps data until it is given back
+	void* data = nullptr;
+	void* cachedData = nullptr;
+	int dataSize = 0;
+	int cachedDataSize = 0;
+
+	auto materialPtr = event.Borrow((const char16_t*)path, data, dataSize, cachedData, cachedDataSize);
+	if (materialPtr == nullptr)
+	{
+		return nullptr;
+	}
+
+	EffekseerPlugin::BorrowedData borrowed((const char16_t*)path, event.GiveBack);
+	if (data == nullptr || dataSize <= 0)
+	{
+		unload_((const char16_t*)path, materialPtr);
+		return nullptr;
+	}
+
+	auto materialData = CreateMaterialData(materialPtr, static_cast<const uint8_t*>(data), dataSize);
+	if (materialData == nullptr)
+	{
+		unload_((const char16_t*)path, materialPtr);
+	}
+	return materialData;
+}
+
+Effekseer::MaterialData* MaterialLoader::LoadCopied(const EFK_CHAR* path)
+{
 	// Load with unity
-	MaterialResource res;
 	int requiredDataSize = 0;
 	int requiredCachedDataSize = 0;
 
@@ -35,18 +105,21 @@ Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 		return nullptr;
 	}
 
+	EffekseerPlugin::MemoryBufferPool::Lease buffer(buffers_);
+	EffekseerPlugin::MemoryBufferPool::Lease bufferForCache(buffers_);
+
 	{
 		// Lack of memory
-		memoryFileForCache_.Resize(requiredCachedDataSize);
-		memoryFile_.Resize(requiredDataSize);
+		bufferForCache.Resize(requiredCachedDataSize);
+		buffer.Resize(requiredDataSize);
 
 		// Load with unity
 		materialPtr = load_((const char16_t*)path,
-							memoryFile_.LoadedBuffer.data(),
-							(int)memoryFile_.LoadedBuffer.size(),
+							buffer.GetData(),
+							(int)buffer.GetSize(),
 							requiredDataSize,
-							memoryFileForCache_.LoadedBuffer.data(),
-							(int)memoryFileForCache_.LoadedBuffer.size(),
+							bufferForCache.GetData(),
+							(int)bufferForCache.GetSize(),
 							requiredCachedDataSize);
 
 		if (materialPtr == nullptr)
@@ -59,43 +132,61 @@ Effekseer::MaterialData* MaterialLoader::Load(const EFK_CHAR* path)
 	// try to load from code
 	if (requiredDataSize > 0)
 	{
-		memoryFile_.LoadedSize = static_cast<size_t>(requiredDataSize);
+		auto materialData = CreateMaterialData(materialPtr, buffer.GetData(), requiredDataSize);
+		if (materialData == nullptr)
+		{
+			unload_((const char16_t*)path, materialPtr);
+		}
+		return materialData;
+	}
 
-		std::shared_ptr<Effekseer::Material> material = std::make_shared<Effekseer::Material>();
-		material->Load((const uint8_t*)memoryFile_.LoadedBuffer.data(), static_cast<int32_t>(memoryFile_.LoadedBuffer.size()));
+	return nullptr;
+}
 
-		res.internalData = new ::Effekseer::MaterialData();
+Effekseer::MaterialData* MaterialLoader::CreateMaterialData(void* materialPtr, const uint8_t* data, int32_t dataSize)
+{
+	// a compressed container is decompressed into a scratch buffer
+	if (EffekseerPlugin::Compression::IsCompressed(data, dataSize))
+	{
+		EffekseerPlugin::MemoryBufferPool::Lease buffer(buffers_);
+		size_t size = static_cast<size_t>(dataSize);
+		if (!EffekseerPlugin::DecompressIfCompressed(data, size, buffer.Get()))
+		{
+			return nullptr;
+		}
+		return CreateMaterialData(materialPtr, data, static_cast<int32_t>(size));
+	}
 
-		auto materialData = res.internalData;
+	std::shared_ptr<Effekseer::Material> material = std::make_shared<Effekseer::Material>();
+	material->Load(data, dataSize);
 
-		materialData->IsSimpleVertex = material->GetIsSimpleVertex();
-		materialData->IsRefractionRequired = material->GetHasRefraction();
-		materialData->CustomData1 = material->GetCustomData1Count();
-		materialData->CustomData2 = material->GetCustomData2Count();
-		materialData->TextureCount = std::min(material->GetTextureCount(), Effekseer::UserTextureSlotMax);
-		materialData->UniformCount = material->GetUniformCount();
-		materialData->ShadingModel = material->GetShadingModel();
+	auto materialData = new ::Effekseer::MaterialData();
 
-		for (int32_t i = 0; i < materialData->TextureCount; i++)
-		{
-			materialData->TextureWrapTypes.at(i) = material->GetTextureWrap(i);
-		}
+	materialData->IsSimpleVertex = material->GetIsSimpleVertex();
+	materialData->IsRefractionRequired = material->GetHasRefraction();
+	materialData->CustomData1 = material->GetCustomData1Count();
+	materialData->CustomData2 = material->GetCustomData2Count();
+	materialData->TextureCount = std::min(material->GetTextureCount(), Effekseer::UserTextureSlotMax);
+	materialData->UniformCount = material->GetUniformCount();
+	materialData->ShadingModel = material->GetShadingModel();
 
-		materialData->UserPtr = new Shader(materialPtr, material, false, false);
-		materialData->ModelUserPtr = new Shader(materialPtr, material, true, false);
+	for (int32_t i = 0; i < materialData->TextureCount; i++)
+	{
+		materialData->TextureWrapTypes.at(i) = material->GetTextureWrap(i);
+	}
 
-		if (material->GetHasRefraction())
-		{
-			materialData->RefractionUserPtr = new Shader(materialPtr, material, false, true);
-			materialData->RefractionModelUserPtr = new Shader(materialPtr, material, true, true);
-		}
+	materialData->UserPtr = new Shader(materialPtr, material, false, false);
+	materialData->ModelUserPtr = new Shader(materialPtr, material, true, false);
 
-		resources.insert(std::make_pair((const char16_t*)path, res));
-		return res.internalData;
+	if (material->GetHasRefraction())
+	{
+		materialData->RefractionUserPtr = new Shader(materialPtr, material, false, true);
+		materialData->RefractionModelUserPtr = new Shader(materialPtr, material, true, true);
 	}
 
-	return nullptr;
+	return materialData;
 }
+
 void MaterialLoader::Unload(Effekseer::MaterialData* data)
 {
 	if (data == nullptr)
@@ -103,37 +194,7 @@ void MaterialLoader::Unload(Effekseer::MaterialData* data)
 		return;
 	}
 
-	auto it = std::find_if(resources.begin(), resources.end(), [data](const std::pair<std::u16string, MaterialResource>& pair) {
-		return pair.second.internalData == data;
-	});
-	if (it == resources.end())
-	{
-		return;
-	}
-
-	it->second.referenceCount--;
-	if (it->second.referenceCount <= 0)
-	{
-		auto ss = static_cast<Shader*>(it->second.internalData->UserPtr);
-		auto sm = static_cast<Shader*>(it->second.internalData->ModelUserPtr);
-		auto srs = static_cast<Shader*>(it->second.internalData->RefractionUserPtr);
-		auto srm = static_cast<Shader*>(it->second.internalData->RefractionModelUserPtr);
-
-		void* ptr = nullptr;
-		if (ss != nullptr)
-		{
-			ptr = ss->GetUnityMaterial();
-		}
-
-		ES_SAFE_DELETE(ss);
-		ES_SAFE_DELETE(sm);
-		ES_SAFE_DELETE(srs);
-		ES_SAFE_DELETE(srm);
-		ES_SAFE_DELETE(it->second.internalData);
-
-		unload_(it->first.c_str(), ptr);
-		resources.erase(it);
-	}
+	resources.Release(data);
 }
 
 } // namespace EffekseerRendererUnity
\ No newline at end of file
@@ -2,9 +2,9 @@
 #pragma once
 
 #include "../common/EffekseerPluginMaterial.h"
+#include "../common/EffekseerPluginResourceRegistry.h"
 #include "../unity/IUnityInterface.h"
 #include <Effekseer.h>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,14 +18,12 @@ class MaterialLoader : public Effekseer::MaterialLoader
 	EffekseerPlugin::MaterialLoaderLoad load_ = nullptr;
 	EffekseerPlugin::MaterialLoaderUnload unload_ = nullptr;
 
-	struct MaterialResource
-	{
-		int referenceCount = 1;
-		Effekseer::MaterialData* internalData;
-	};
-	std::map<std::u16string, MaterialResource> resources;
-	EffekseerPlugin::MemoryFile memoryFile_;
-	EffekseerPlugin::MemoryFile memoryFileForCache_;
+	EffekseerPlugin::ResourceRegistry<Effekseer::MaterialData*> resources;
+	EffekseerPlugin::MemoryBufferPool buffers_;
+
+	Effekseer::MaterialData* LoadCopied(const EFK_CHAR* path);
+	Effekseer::MaterialData* LoadBorrowed(const EFK_CHAR* path, const EffekseerPlugin::MaterialLoaderBorrowEvent& event);
+	Effekseer::MaterialData* CreateMaterialData(void* materialPtr, const uint8_t* data, int32_t dataSize);
 
 public:
 	MaterialLoader(EffekseerPlugin::MaterialLoaderLoad load, EffekseerPlugin::MaterialLoaderUnload unload);
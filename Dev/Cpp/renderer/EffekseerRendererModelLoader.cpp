@@ -1,31 +1,83 @@
 #include "EffekseerRendererModelLoader.h"
 #include "EffekseerRendererImplemented.h"
-
-#include <algorithm>
+#include "../common/EffekseerPluginCompression.h"
 
 namespace EffekseerRendererUnity
 {
-ModelLoader::ModelLoader(EffekseerPlugin::ModelLoaderLoad load, EffekseerPlugin::ModelLoaderUnload unload) : load(load), unload(unload)
+ModelLoader::ModelLoader(EffekseerPlugin::ModelLoaderLoad load, EffekseerPlugin::ModelLoaderUnload unload)
+	: load(load), unload(unload), buffers(1024 * 1024)
 {
-	internalBuffer.resize(1024 * 1024);
+	resources.SetReleaseCallback([this](const std::u16string& path, void* internalData) {
+		auto model = (Model*)internalData;
+		this->unload(path.c_str(), model->InternalPtr);
+		ES_SAFE_DELETE(model);
+	});
 }
 
 void* ModelLoader::Load(const EFK_CHAR* path)
 {
 	// find it from resource table and if it exists, it is reused.
-	auto it = resources.find((const char16_t*)path);
-	if (it != resources.end())
+	void* internalData = nullptr;
+	if (resources.Acquire((const char16_t*)path, internalData))
+	{
+		return internalData;
+	}
+
+	Model* model = nullptr;
+	auto event = EffekseerPlugin::ModelLoader::GetBorrowEvent();
+	if (event.Borrow != nullptr)
+	{
+		model = LoadBorrowed(path, event);
+	}
+	else
+	{
+		model = LoadCopied(path);
+	}
+
+	if (model == nullptr)
+	{
+		resources.Cancel((const char16_t*)path);
+		return nullptr;
+	}
+
+	resources.Add((const char16_t*)path, model);
+	return model;
+}
+
+Model* ModelLoader::LoadBorrowed(const EFK_CHAR* path, const EffekseerPlugin::ModelLoaderBorrowEvent& event)
+{
+	// Unity keeps data until it is given back
+	void* data = nullptr;
+	int dataSize = 0;
+	auto modelPtr = event.Borrow((const char16_t*)path, data, dataSize);
+	if (modelPtr == nullptr)
+	{
+		return nullptr;
+	}
+
+	EffekseerPlugin::BorrowedData borrowed((const char16_t*)path, event.GiveBack);
+	if (data == nullptr || dataSize <= 0)
+	{
+		unload((const char16_t*)path, modelPtr);
+		return nullptr;
+	}
+
+	auto model = CreateModel(modelPtr, static_cast<const uint8_t*>(data), static_cast<size_t>(dataSize));
+	if (model == nullptr)
 	{
-		it->second.referenceCount++;
-		return it->second.internalData;
+		unload((const char16_t*)path, modelPtr);
 	}
+	return model;
+}
 
+Model* ModelLoader::LoadCopied(const EFK_CHAR* path)
+{
 	// Load with unity
-	ModelResource res;
+	EffekseerPlugin::MemoryBufferPool::Lease buffer(buffers);
 	int requiredDataSize = 0;
 	void* modelPtr = nullptr;
 
-	modelPtr = load((const char16_t*)path, internalBuffer.data(), internalBuffer.size(), requiredDataSize);
+	modelPtr = load((const char16_t*)path, buffer.GetData(), (int)buffer.GetSize(), requiredDataSize);
 
 	if (requiredDataSize == 0)
 	{
@@ -36,9 +88,9 @@ void* ModelLoader::Load(const EFK_CHAR* path)
 	if (modelPtr == nullptr)
 	{
 		// reallocate a buffer
-		internalBuffer.resize(requiredDataSize);
+		buffer.Resize(requiredDataSize);
 
-		modelPtr = load((const char16_t*)path, internalBuffer.data(), internalBuffer.size(), requiredDataSize);
+		modelPtr = load((const char16_t*)path, buffer.GetData(), (int)buffer.GetSize(), requiredDataSize);
 
 		if (modelPtr == nullptr)
 		{
@@ -46,14 +98,30 @@ void* ModelLoader::Load(const EFK_CHAR* path)
 		}
 	}
 
-	internalBuffer.resize(requiredDataSize);
+	auto model = CreateModel(modelPtr, buffer.GetData(), static_cast<size_t>(requiredDataSize));
+	if (model == nullptr)
+	{
+		unload((const char16_t*)path, modelPtr);
+	}
+	return model;
+}
 
-	auto model = new Model(internalBuffer.data(), internalBuffer.size());
-	model->InternalPtr = modelPtr;
-	res.internalData = model;
+Model* ModelLoader::CreateModel(void* modelPtr, const uint8_t* data, size_t dataSize)
+{
+	// a compressed container is decompressed into a scratch buffer
+	if (EffekseerPlugin::Compression::IsCompressed(data, dataSize))
+	{
+		EffekseerPlugin::MemoryBufferPool::Lease buffer(buffers);
+		if (!EffekseerPlugin::DecompressIfCompressed(data, dataSize, buffer.Get()))
+		{
+			return nullptr;
+		}
+		return CreateModel(modelPtr, data, dataSize);
+	}
 
-	resources.insert(std::make_pair((const char16_t*)path, res));
-	return res.internalData;
+	auto model = new Model(const_cast<uint8_t*>(data), static_cast<int32_t>(dataSize));
+	model->InternalPtr = modelPtr;
+	return model;
 }
 
 void ModelLoader::Unload(void* source)
@@ -63,24 +131,7 @@ void ModelLoader::Unload(void* source)
 		return;
 	}
 
-	// find a model
-	auto it = std::find_if(resources.begin(), resources.end(), [source](const std::pair<std::u16string, ModelResource>& pair) {
-		return pair.second.internalData == source;
-	});
-	if (it == resources.end())
-	{
-		return;
-	}
-
 	// if refrercen count is zero, it is released
-	it->second.referenceCount--;
-	if (it->second.referenceCount <= 0)
-	{
-		auto model = (Model*)it->second.internalData;
-		unload(it->first.c_str(), model->InternalPtr);
-		ES_SAFE_DELETE(model);
-		it->second.internalData = nullptr;
-		resources.erase(it);
-	}
+	resources.Release(source);
 }
 } // namespace EffekseerRendererUnity
\ No newline at end of file
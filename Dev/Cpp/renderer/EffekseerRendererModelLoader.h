@@ -2,6 +2,8 @@
 #pragma once
 
 #include "../common/EffekseerPluginModel.h"
+#include "../common/EffekseerPluginResourceRegistry.h"
+#include "../common/MemoryFile.h"
 #include "../unity/IUnityInterface.h"
 
 #ifdef __EFFEKSEER_FROM_MAIN_CMAKE__
@@ -10,25 +12,25 @@
 #include <Effekseer.h>
 #endif
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace EffekseerRendererUnity
 {
+class Model;
+
 class ModelLoader : public Effekseer::ModelLoader
 {
 	EffekseerPlugin::ModelLoaderLoad load;
 	EffekseerPlugin::ModelLoaderUnload unload;
 
-	struct ModelResource
-	{
-		int referenceCount = 1;
-		void* internalData;
-	};
-	std::map<std::u16string, ModelResource> resources;
-	std::vector<uint8_t> internalBuffer;
+	EffekseerPlugin::ResourceRegistry<void*> resources;
+	EffekseerPlugin::MemoryBufferPool buffers;
+
+	Model* LoadCopied(const EFK_CHAR* path);
+	Model* LoadBorrowed(const EFK_CHAR* path, const EffekseerPlugin::ModelLoaderBorrowEvent& event);
+	Model* CreateModel(void* modelPtr, const uint8_t* data, size_t dataSize);
 
 public:
 	ModelLoader(EffekseerPlugin::ModelLoaderLoad load, EffekseerPlugin::ModelLoaderUnload unload);
@@ -1,16 +1,30 @@
 #include "EffekseerRendererTextureLoader.h"
-#include <algorithm>
 
 namespace EffekseerRendererUnity
 {
+TextureLoader::TextureLoader(EffekseerPlugin::TextureLoaderLoad load, EffekseerPlugin::TextureLoaderUnload unload)
+	: load(load), unload(unload)
+{
+	resources.SetReleaseCallback([this](const std::u16string& path, Effekseer::TextureData* textureData) {
+		// Unload from unity
+		void* texturePtr = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+			texturePtr = textureData2NativePtr[textureData];
+			textureData2NativePtr.erase(textureData);
+		}
+		this->unload(path.c_str(), texturePtr);
+		ES_SAFE_DELETE(textureData);
+	});
+}
+
 Effekseer::TextureData* TextureLoader::Load(const EFK_CHAR* path, Effekseer::TextureType textureType)
 {
 	// find it from resource table and if it exists, it is reused.
-	auto it = resources.find((const char16_t*)path);
-	if (it != resources.end())
+	Effekseer::TextureData* textureData = nullptr;
+	if (resources.Acquire((const char16_t*)path, textureData))
 	{
-		it->second.referenceCount++;
-		return it->second.textureDataPtr;
+		return textureData;
 	}
 
 	// Load with unity
@@ -18,20 +32,23 @@ Effekseer::TextureData* TextureLoader::Load(const EFK_CHAR* path, Effekseer::Tex
 	void* texturePtr = load((const char16_t*)path, &width, &height, &format);
 	if (texturePtr == nullptr)
 	{
+		resources.Cancel((const char16_t*)path);
 		return nullptr;
 	}
 
-	auto added = resources.insert(std::make_pair((const char16_t*)path, TextureResource()));
-	TextureResource& res = added.first->second;
-	res.textureDataPtr = new Effekseer::TextureData();
-	res.textureDataPtr->Width = width;
-	res.textureDataPtr->Height = height;
-	res.textureDataPtr->TextureFormat = (Effekseer::TextureFormatType)format;
-	res.textureDataPtr->UserPtr = texturePtr;
+	textureData = new Effekseer::TextureData();
+	textureData->Width = width;
+	textureData->Height = height;
+	textureData->TextureFormat = (Effekseer::TextureFormatType)format;
+	textureData->UserPtr = texturePtr;
 
-	textureData2NativePtr[res.textureDataPtr] = texturePtr;
+	{
+		std::lock_guard<std::mutex> lock(textureData2NativePtrMutex);
+		textureData2NativePtr[textureData] = texturePtr;
+	}
+	resources.Add((const char16_t*)path, textureData);
 
-	return res.textureDataPtr;
+	return textureData;
 }
 
 void TextureLoader::Unload(Effekseer::TextureData* source)
@@ -41,24 +58,7 @@ void TextureLoader::Unload(Effekseer::TextureData* source)
 		return;
 	}
 
-	// find a texture
-	auto it = std::find_if(resources.begin(), resources.end(), [source](const std::pair<std::u16string, TextureResource>& pair) {
-		return pair.second.textureDataPtr->UserPtr == source->UserPtr;
-	});
-	if (it == resources.end())
-	{
-		return;
-	}
-
 	// if refrercen count is zero, it is released
-	it->second.referenceCount--;
-	if (it->second.referenceCount <= 0)
-	{
-		// Unload from unity
-		unload(it->first.c_str(), textureData2NativePtr[source]);
-		textureData2NativePtr.erase(source);
-		ES_SAFE_DELETE(it->second.textureDataPtr);
-		resources.erase(it);
-	}
+	resources.Release(source);
 }
 } // namespace EffekseerRendererUnity
\ No newline at end of file
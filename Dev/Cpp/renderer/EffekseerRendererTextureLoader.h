@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "../common/EffekseerPluginResourceRegistry.h"
 #include "../common/EffekseerPluginTexture.h"
 #include "../unity/IUnityInterface.h"
 
@@ -10,8 +11,9 @@
 #include <Effekseer.h>
 #endif
 
-#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace EffekseerRendererUnity
 {
@@ -21,17 +23,13 @@ protected:
 	EffekseerPlugin::TextureLoaderLoad load;
 	EffekseerPlugin::TextureLoaderUnload unload;
 
-	struct TextureResource
-	{
-		int referenceCount = 1;
-		Effekseer::TextureData* textureDataPtr = nullptr;
-	};
-	std::map<std::u16string, TextureResource> resources;
-	std::map<void*, void*> textureData2NativePtr;
+	EffekseerPlugin::ResourceRegistry<Effekseer::TextureData*> resources;
+	std::unordered_map<void*, void*> textureData2NativePtr;
+	std::mutex textureData2NativePtrMutex;
 
 public:
 	static TextureLoader* Create(EffekseerPlugin::TextureLoaderLoad load, EffekseerPlugin::TextureLoaderUnload unload);
-	TextureLoader(EffekseerPlugin::TextureLoaderLoad load, EffekseerPlugin::TextureLoaderUnload unload) : load(load), unload(unload) {}
+	TextureLoader(EffekseerPlugin::TextureLoaderLoad load, EffekseerPlugin::TextureLoaderUnload unload);
 	virtual ~TextureLoader() {}
 	Effekseer::TextureData* Load(const EFK_CHAR* path, Effekseer::TextureType textureType) override;
 	void Unload(Effekseer::TextureData* source) override;
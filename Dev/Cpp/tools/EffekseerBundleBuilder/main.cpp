@@ -0,0 +1,420 @@
+// EffekseerBundleBuilder
+// Pack files in a directory into a bundle (.efkpkg) which the plugin maps and looks up by paths.
+//
+// usage: EffekseerBundleBuilder [-z] <input directory> <output file>
+//   -z : compress each file with LZ4 if it becomes smaller
+
+#include "../../common/EffekseerPluginBundleFormat.h"
+#include "../../common/EffekseerPluginCompression.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+using namespace EffekseerPlugin;
+
+namespace
+{
+
+struct SourceFile
+{
+	//! a path relative to an input directory
+	std::u16string Path;
+	std::string FullPath;
+};
+
+std::u16string ConvertToUtf16(const std::string& path)
+{
+	std::u16string ret;
+
+	for (size_t i = 0; i < path.size();)
+	{
+		auto c = static_cast<uint8_t>(path[i]);
+		uint32_t code = 0;
+		size_t length = 1;
+
+		if (c < 0x80)
+		{
+			code = c;
+		}
+		else if ((c & 0xE0) == 0xC0)
+		{
+			code = c & 0x1F;
+			length = 2;
+		}
+		else if ((c & 0xF0) == 0xE0)
+		{
+			code = c & 0x0F;
+			length = 3;
+		}
+		else
+		{
+			code = c & 0x07;
+			length = 4;
+		}
+
+		for (size_t j = 1; j < length && i + j < path.size(); j++)
+		{
+			code = (code << 6) | (static_cast<uint8_t>(path[i + j]) & 0x3F);
+		}
+		i += length;
+
+		if (code >= 0x10000)
+		{
+			code -= 0x10000;
+			ret.push_back(static_cast<char16_t>(0xD800 + (code >> 10)));
+			ret.push_back(static_cast<char16_t>(0xDC00 + (code & 0x3FF)));
+		}
+		else
+		{
+			ret.push_back(static_cast<char16_t>(code));
+		}
+	}
+
+	return ret;
+}
+
+#if defined(_WIN32)
+
+std::string ConvertToUtf8(const std::wstring& path)
+{
+	auto size = WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, nullptr, 0, nullptr, nullptr);
+	std::string ret(size > 0 ? size - 1 : 0, '\0');
+	if (size > 1)
+	{
+		WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, &ret[0], size, nullptr, nullptr);
+	}
+	return ret;
+}
+
+std::wstring ConvertToWide(const std::string& path)
+{
+	auto size = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+	std::wstring ret(size > 0 ? size - 1 : 0, L'\0');
+	if (size > 1)
+	{
+		MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &ret[0], size);
+	}
+	return ret;
+}
+
+void CollectFiles(const std::string& root, const std::string& relative, std::vector<SourceFile>& files)
+{
+	auto directory = root + "/" + relative;
+
+	WIN32_FIND_DATAW data;
+	auto handle = FindFirstFileW(ConvertToWide(directory + "*").c_str(), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	do
+	{
+		auto name = ConvertToUtf8(data.cFileName);
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		{
+			CollectFiles(root, relative + name + "/", files);
+		}
+		else
+		{
+			SourceFile file;
+			file.Path = ConvertToUtf16(relative + name);
+			file.FullPath = directory + name;
+			files.push_back(file);
+		}
+	} while (FindNextFileW(handle, &data));
+
+	FindClose(handle);
+}
+
+FILE* OpenFile(const std::string& path, const char* mode)
+{
+	return _wfopen(ConvertToWide(path).c_str(), ConvertToWide(mode).c_str());
+}
+
+#else
+
+void CollectFiles(const std::string& root, const std::string& relative, std::vector<SourceFile>& files)
+{
+	auto directory = root + "/" + relative;
+
+	auto dir = opendir(directory.c_str());
+	if (dir == nullptr)
+	{
+		return;
+	}
+
+	while (auto entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		struct stat status;
+		if (stat((directory + name).c_str(), &status) != 0)
+		{
+			continue;
+		}
+
+		if (S_ISDIR(status.st_mode))
+		{
+			CollectFiles(root, relative + name + "/", files);
+		}
+		else if (S_ISREG(status.st_mode))
+		{
+			SourceFile file;
+			file.Path = ConvertToUtf16(relative + name);
+			file.FullPath = directory + name;
+			files.push_back(file);
+		}
+	}
+
+	closedir(dir);
+}
+
+FILE* OpenFile(const std::string& path, const char* mode) { return fopen(path.c_str(), mode); }
+
+#endif
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>& data)
+{
+	auto fp = OpenFile(path, "rb");
+	if (fp == nullptr)
+	{
+		return false;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	auto size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+	auto read = fread(data.data(), 1, data.size(), fp);
+	fclose(fp);
+
+	return read == data.size();
+}
+
+uint64_t Align(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+void WriteLength(std::vector<uint8_t>& dst, size_t length)
+{
+	while (length >= 255)
+	{
+		dst.push_back(255);
+		length -= 255;
+	}
+	dst.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(std::vector<uint8_t>& dst, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+	const size_t tokenMatch = matchLength > 0 ? matchLength - 4 : 0;
+	dst.push_back(static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) | (tokenMatch < 15 ? tokenMatch : 15)));
+
+	if (literalLength >= 15)
+	{
+		WriteLength(dst, literalLength - 15);
+	}
+	dst.insert(dst.end(), literals, literals + literalLength);
+
+	if (matchLength == 0)
+	{
+		return;
+	}
+
+	dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+	dst.push_back(static_cast<uint8_t>(offset >> 8));
+
+	if (tokenMatch >= 15)
+	{
+		WriteLength(dst, tokenMatch - 15);
+	}
+}
+
+//! compress data into a container with a greedy LZ4 block encoder
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& src)
+{
+	// rules of LZ4 blocks for the end of data
+	const size_t MinMatch = 4;
+	const size_t LastLiterals = 5;
+	const size_t MatchFindLimit = 12;
+	const size_t MaxOffset = 65535;
+
+	Compression::Header header;
+	memcpy(header.Magic, Compression::Magic, sizeof(header.Magic));
+	header.Method = Compression::Codec::LZ4;
+	header.RawSize = src.size();
+
+	std::vector<uint8_t> dst(sizeof(header));
+	memcpy(dst.data(), &header, sizeof(header));
+
+	auto read32 = [&src](size_t i) {
+		uint32_t v;
+		memcpy(&v, &src[i], sizeof(v));
+		return v;
+	};
+
+	std::vector<int64_t> table(1 << 16, -1);
+	size_t anchor = 0;
+	size_t i = 0;
+	const size_t limit = src.size() > MatchFindLimit ? src.size() - MatchFindLimit : 0;
+
+	while (i < limit)
+	{
+		const auto sequence = read32(i);
+		const auto hash = (sequence * 2654435761U) >> 16;
+		const auto candidate = table[hash];
+		table[hash] = static_cast<int64_t>(i);
+
+		if (candidate < 0 || i - static_cast<size_t>(candidate) > MaxOffset || read32(static_cast<size_t>(candidate)) != sequence)
+		{
+			i++;
+			continue;
+		}
+
+		size_t matchLength = MinMatch;
+		while (i + matchLength < src.size() - LastLiterals && src[static_cast<size_t>(candidate) + matchLength] == src[i + matchLength])
+		{
+			matchLength++;
+		}
+
+		WriteSequence(dst, src.data() + anchor, i - anchor, i - static_cast<size_t>(candidate), matchLength);
+		i += matchLength;
+		anchor = i;
+	}
+
+	WriteSequence(dst, src.data() + anchor, src.size() - anchor, 0, 0);
+	return dst;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	bool compresses = argc >= 2 && strcmp(argv[1], "-z") == 0;
+	if (argc < (compresses ? 4 : 3))
+	{
+		printf("usage: %s [-z] <input directory> <output file>\n", argv[0]);
+		return 1;
+	}
+
+	const char* inputPath = argv[compresses ? 2 : 1];
+	const char* outputPath = argv[compresses ? 3 : 2];
+
+	std::string root = inputPath;
+	while (!root.empty() && (root.back() == '/' || root.back() == '\\'))
+	{
+		root.pop_back();
+	}
+
+	std::vector<SourceFile> files;
+	CollectFiles(root, "", files);
+
+	struct PackedFile
+	{
+		BundleFormat::Entry Entry;
+		std::u16string Path;
+		std::string FullPath;
+	};
+
+	std::vector<PackedFile> packedFiles;
+	for (const auto& file : files)
+	{
+		PackedFile packed;
+		packed.Path = BundleFormat::NormalizePath(file.Path.c_str());
+		packed.FullPath = file.FullPath;
+		memset(&packed.Entry, 0, sizeof(packed.Entry));
+		packed.Entry.PathHash = BundleFormat::HashPath(packed.Path);
+		packedFiles.push_back(packed);
+	}
+
+	// the plugin finds entries with a binary search
+	std::sort(packedFiles.begin(), packedFiles.end(), [](const PackedFile& a, const PackedFile& b) {
+		return a.Entry.PathHash != b.Entry.PathHash ? a.Entry.PathHash < b.Entry.PathHash : a.Path < b.Path;
+	});
+
+	std::u16string paths;
+	for (auto& file : packedFiles)
+	{
+		file.Entry.PathOffset = static_cast<uint32_t>(paths.size());
+		file.Entry.PathLength = static_cast<uint32_t>(file.Path.size());
+		paths += file.Path;
+	}
+
+	BundleFormat::Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.Magic, BundleFormat::Magic, sizeof(header.Magic));
+	header.Version = BundleFormat::Version;
+	header.EntryCount = static_cast<uint32_t>(packedFiles.size());
+	header.PathsOffset = sizeof(BundleFormat::Header) + sizeof(BundleFormat::Entry) * packedFiles.size();
+	header.PathsSize = paths.size() * sizeof(char16_t);
+
+	std::vector<uint8_t> body;
+	auto dataOffset = Align(header.PathsOffset + header.PathsSize, BundleFormat::DataAlignment);
+
+	for (auto& file : packedFiles)
+	{
+		std::vector<uint8_t> data;
+		if (!ReadFile(file.FullPath, data))
+		{
+			printf("failed to read %s\n", file.FullPath.c_str());
+			return 1;
+		}
+
+		if (compresses)
+		{
+			auto compressed = Compress(data);
+			if (compressed.size() < data.size())
+			{
+				data = std::move(compressed);
+			}
+		}
+
+		auto offset = Align(dataOffset + body.size(), BundleFormat::DataAlignment);
+		body.resize(static_cast<size_t>(offset - dataOffset), 0);
+		body.insert(body.end(), data.begin(), data.end());
+
+		file.Entry.DataOffset = offset;
+		file.Entry.DataSize = data.size();
+	}
+
+	auto fp = OpenFile(outputPath, "wb");
+	if (fp == nullptr)
+	{
+		printf("failed to open %s\n", outputPath);
+		return 1;
+	}
+
+	fwrite(&header, sizeof(header), 1, fp);
+	for (const auto& file : packedFiles)
+	{
+		fwrite(&file.Entry, sizeof(file.Entry), 1, fp);
+	}
+	fwrite(paths.data(), sizeof(char16_t), paths.size(), fp);
+
+	std::vector<uint8_t> padding(static_cast<size_t>(dataOffset - header.PathsOffset - header.PathsSize), 0);
+	fwrite(padding.data(), 1, padding.size(), fp);
+	fwrite(body.data(), 1, body.size(), fp);
+	fclose(fp);
+
+	printf("packed %d files into %s\n", static_cast<int>(packedFiles.size()), outputPath);
+	return 0;
+}
@@ -17,6 +17,14 @@ namespace Effekseer
 			return res;
 		}
 
+		// Writes a matrix with the layout of Effekseer::Matrix43 (axis x, y, z and translation)
+		public static void Matrix2Array43(Matrix4x4 mat, float[] dst, int offset) {
+			dst[offset + 0] = mat.m00; dst[offset + 1] = mat.m10; dst[offset + 2] = mat.m20;
+			dst[offset + 3] = mat.m01; dst[offset + 4] = mat.m11; dst[offset + 5] = mat.m21;
+			dst[offset + 6] = mat.m02; dst[offset + 7] = mat.m12; dst[offset + 8] = mat.m22;
+			dst[offset + 9] = mat.m03; dst[offset +10] = mat.m13; dst[offset +11] = mat.m23;
+		}
+
 		public static float TimeToFrames(float time) {
 			return time * 60.0f;
 		}
@@ -113,9 +121,24 @@ namespace Effekseer
 		[DllImport(pluginName)]
 		public static extern float EffekseerGetEffectMagnification(IntPtr effect);
 
+		[DllImport(pluginName)]
+		public static extern int EffekseerPrewarmEffect(IntPtr effect, int count);
+
 		[DllImport(pluginName)]
 		public static extern int EffekseerPlayEffect(IntPtr effect, float x, float y, float z);
 
+		[DllImport(pluginName)]
+		public static extern int EffekseerPlayEffectAtFrame(IntPtr effect, float x, float y, float z, int startFrame);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerPlaySeekableEffect(IntPtr effect, float x, float y, float z, float frame);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerSeekHandle(int handle, float frame);
+
+		[DllImport(pluginName)]
+		public static extern float EffekseerGetHandleFrame(int handle);
+
 		[DllImport(pluginName)]
 		public static extern void EffekseerUpdateHandle(int handle, float deltaDrame);
 
@@ -188,6 +211,268 @@ namespace Effekseer
 		[DllImport(pluginName)]
 		public static extern void EffekseerSetDynamicInput(int handle, int index, float value);
 
+		#region Command
+
+		// The values must be same as EffekseerPlugin::CommandType
+		public enum CommandType : int
+		{
+			Play = 0,
+			Stop = 1,
+			StopRoot = 2,
+			SetLocation = 3,
+			SetRotation = 4,
+			SetScale = 5,
+			SetAllColor = 6,
+			SetTargetLocation = 7,
+			SetDynamicInput = 8,
+			SetSpeed = 9,
+			SetPaused = 10,
+			SetShown = 11,
+			SetLayer = 12,
+			SetMatrix = 13,
+		}
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerSubmitCommands(byte[] buffer, int size, int[] outHandles, int outHandleCount);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetMatrices(int[] handles, float[] matrices4x3, int count);
+
+		// The values must be same as EffekseerPlugin::HandleFlags
+		[Flags]
+		public enum HandleFlags : byte
+		{
+			Exists = 1 << 0,
+			Shown = 1 << 1,
+			Paused = 1 << 2,
+			Finished = 1 << 3,
+		}
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerQueryHandles(int[] handles, int count, byte[] outFlags, int[] outInstanceCounts);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerPlayEffects(IntPtr effect, float[] positions, int count, int[] startFrames, int[] layers, int[] outHandles);
+
+		#endregion
+
+		#region Group
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerPlayEffectWithGroup(IntPtr effect, float x, float y, float z, int group);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetGroup(int handle, int group);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetGroup(int handle);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetGroupCount(int group);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerStopGroup(int group);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetPausedToGroup(int group, bool paused);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetShownToGroup(int group, bool shown);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetSpeedToGroup(int group, float speed);
+
+		#endregion
+
+		#region Scheduler
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetUpdateSchedulerEnabled(bool enabled);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetOffscreenSuspension(bool enabled, int suspensionFrames, float maxCatchUpFrames);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetUpdateSchedulerThresholds(float[] distances, int[] intervals, int count, int culledInterval);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetHandleScheduled(int handle, bool scheduled, float radius);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetHandleUpdateInterval(int handle);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetHandleTickCount(int handle);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetHandleSuspended(int handle);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerGetUpdateSchedulerStats(out int scheduledCount, out int tickedCount, out int skippedCount, out int suspendedCount);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetUpdateBudget(int microseconds);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetHandleUpdatePriority(int handle, int priority);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetGroupUpdatePriority(int group, int priority);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerGetUpdateBudgetStats(out float updateMicroseconds, out int deferredCount, out int overrunCount);
+
+		#endregion
+
+		#region Budget
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetInstanceBudget(int maxHandles, int maxInstances, bool evictionEnabled, float distanceWeight);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetEffectPriority(IntPtr effect, int priority);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerGetInstanceBudget(out int maxHandles, out int maxInstances, out int handleCount, out int instanceCount, out int refusedCount, out int evictedCount);
+
+		#endregion
+
+		#region Instancing
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerCreateInstancedEffect(IntPtr effect, int bucketCount, float phaseFrames);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerDestroyInstancedEffect(int id);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetInstancedTransforms(int id, float[] matrices, float[] timeOffsets, int count);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetInstancedEffectHandle(int id, int bucket);
+
+		#endregion
+
+		#region Bake
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerBakeEffect(IntPtr effect, int startFrame, int frameCount);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerLoadBakedClip(IntPtr effect, byte[] data, int size);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerSaveBakedClip(int id, byte[] data, int size);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetBakedClipTransforms(int id, float[] matrices, float[] timeOffsets, int count);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerDestroyBakedClip(int id);
+
+		#endregion
+
+		#region Managers
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerCreateManager(int maxInstances);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerDestroyManager(int id);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerUpdate(int id, float deltaFrame);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetRendered(int id, bool rendered);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerManagerPlayEffect(int id, IntPtr effect, float x, float y, float z);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerStopEffect(int id, int handle);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerStopAllEffects(int id);
+
+		[DllImport(pluginName)]
+		public static extern bool EffekseerManagerExists(int id, int handle);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetLocation(int id, int handle, float x, float y, float z);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetRotation(int id, int handle, float x, float y, float z, float angle);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetScale(int id, int handle, float x, float y, float z);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetShown(int id, int handle, bool shown);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetPaused(int id, int handle, bool paused);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerManagerSetSpeed(int id, int handle, float speed);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerManagerGetInstanceCount(int id);
+
+		#endregion
+
+		#region Async Loading
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerLoadEffectAsync(byte[] data, int size, IntPtr path, float magnification);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerPumpEffectLoads(float maxMilliseconds);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetLoadEffectState(int ticket);
+
+		[DllImport(pluginName)]
+		public static extern IntPtr EffekseerTakeLoadedEffect(int ticket);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetPumpingLoadTicket();
+
+		#endregion
+
+		#region Material Loading
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetMaterialLoadBudget(float maxMilliseconds, int maxCount);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetPendingMaterialCount();
+
+		#endregion
+
+		#region File Mapping
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetFileMappingEnabled(bool enabled);
+
+		[DllImport(pluginName)]
+		public static extern IntPtr EffekseerLoadEffectWithFileMapping(IntPtr path, float magnification);
+
+		#endregion
+
+		#region Bundles
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerOpenBundle(IntPtr path);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerCloseBundle(int id);
+
+		[DllImport(pluginName)]
+		public static extern IntPtr EffekseerLoadEffectFromBundle(int id, IntPtr path, float magnification);
+
+		#endregion
+
 		[DllImport(pluginName)]
 		public static extern void EffekseerSetTextureLoaderEvent(
 			EffekseerTextureLoaderLoad load,
@@ -211,6 +496,21 @@ namespace Effekseer
 			IntPtr cachedMaterialBuffer, int cachedMaterialBufferSize, ref int requiredCachedMaterialBufferSize);
 		public delegate void EffekseerMaterialLoaderUnload(IntPtr path, IntPtr modelPtr);
 
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetModelLoaderBorrowEvent(
+			EffekseerModelLoaderBorrow borrow,
+			EffekseerLoaderGiveBack giveBack);
+		public delegate IntPtr EffekseerModelLoaderBorrow(IntPtr path, ref IntPtr data, ref int dataSize);
+		public delegate void EffekseerLoaderGiveBack(IntPtr path);
+
+		[DllImport(pluginName)]
+		public static extern void EffekseerSetMaterialLoaderBorrowEvent(
+			EffekseerMaterialLoaderBorrow borrow,
+			EffekseerLoaderGiveBack giveBack);
+		public delegate IntPtr EffekseerMaterialLoaderBorrow(IntPtr path,
+			ref IntPtr materialData, ref int materialDataSize,
+			ref IntPtr cachedMaterialData, ref int cachedMaterialDataSize);
+
 		[DllImport(pluginName)]
 		public static extern void EffekseerSetSoundLoaderEvent(
 			EffekseerSoundLoaderLoad load,
@@ -341,6 +641,12 @@ namespace Effekseer
 		[DllImport(pluginName)]
 		public static extern IntPtr GetUnityRenderInfoBuffer();
 
+		[DllImport(pluginName)]
+		public static extern int EffekseerGetDecompressedSize(byte[] data, int size);
+
+		[DllImport(pluginName)]
+		public static extern int EffekseerDecompress(byte[] data, int size, byte[] dst, int dstSize);
+
 		#endregion
 
 		#region Network
@@ -25,6 +25,33 @@ namespace Effekseer
 		{
 			Plugin.EffekseerUpdateHandle(m_handle, deltaFrame);
 		}
+
+		/// <summary xml:lang="en">
+		/// Moves the effect which is played by EffekseerSystem.PlaySeekableEffect to the frame.
+		/// When it is moved backward, the effect is played again and this handle is replaced.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// EffekseerSystem.PlaySeekableEffect で再生したエフェクトを指定フレームに移動する。
+		/// 後ろに移動する場合、エフェクトは再生し直され、このハンドルは置き換えられる。
+		/// </summary>
+		public void Seek(float frame)
+		{
+			m_handle = Plugin.EffekseerSeekHandle(m_handle, frame);
+		}
+
+		/// <summary xml:lang="en">
+		/// Current frame of the effect which is played by EffekseerSystem.PlaySeekableEffect. It is negative for other effects.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// EffekseerSystem.PlaySeekableEffect で再生したエフェクトの現在のフレーム。それ以外のエフェクトでは負の値
+		/// </summary>
+		public float frame
+		{
+			get
+			{
+				return Plugin.EffekseerGetHandleFrame(m_handle);
+			}
+		}
 		
 		/// <summary xml:lang="en">
 		/// Stops the played effect.
@@ -200,6 +227,92 @@ namespace Effekseer
 			}
 		}
 
+		/// <summary xml:lang="en">
+		/// Group to pause, stop, hide or change speed together. -1 means no group.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// まとめて一時停止、停止、非表示、速度変更するためのグループ。-1はグループなし
+		/// </summary>
+		public int group
+		{
+			set
+			{
+				Plugin.EffekseerSetGroup(m_handle, value);
+			}
+			get
+			{
+				return Plugin.EffekseerGetGroup(m_handle);
+			}
+		}
+
+		/// <summary xml:lang="en">
+		/// Whether the update rate is reduced by the update scheduler
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 更新スケジューラーによって更新頻度を下げるかどうか
+		/// </summary>
+		/// <param name="scheduled"></param>
+		/// <param name="radius">Radius of the effect used to test whether it is out of cameras</param>
+		public void SetScheduled(bool scheduled, float radius = 1.0f)
+		{
+			Plugin.EffekseerSetHandleScheduled(m_handle, scheduled, radius);
+		}
+
+		/// <summary xml:lang="en">
+		/// Update interval in frames selected by the update scheduler
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 更新スケジューラーが選択した更新間隔(フレーム)
+		/// </summary>
+		public int updateInterval
+		{
+			get
+			{
+				return Plugin.EffekseerGetHandleUpdateInterval(m_handle);
+			}
+		}
+
+		/// <summary xml:lang="en">
+		/// The number of updates by the update scheduler
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 更新スケジューラーによる更新回数
+		/// </summary>
+		public int tickCount
+		{
+			get
+			{
+				return Plugin.EffekseerGetHandleTickCount(m_handle);
+			}
+		}
+
+		/// <summary xml:lang="en">
+		/// Whether the update is suspended because the effect is out of all cameras
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// すべてのカメラ外にあるため更新が停止されているかどうか
+		/// </summary>
+		public bool suspended
+		{
+			get
+			{
+				return Plugin.EffekseerGetHandleSuspended(m_handle) != 0;
+			}
+		}
+
+		/// <summary xml:lang="en">
+		/// Set an update priority which is used when the update budget is exceeded. A higher priority is updated first.
+		/// It does not enable update scheduling of the effect.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 更新予算を超えたときに使用される更新優先度を設定する。優先度が高いほど先に更新される。
+		/// エフェクトの更新スケジューリングは有効にしない。
+		/// </summary>
+		public void SetUpdatePriority(int priority)
+		{
+			Plugin.EffekseerSetHandleUpdatePriority(m_handle, priority);
+		}
+
 		/// <summary xml:lang="en">
 		/// Playback speed
 		/// </summary>
@@ -51,9 +51,7 @@ namespace Effekseer
 
 			if (!Application.isPlaying) {
 				if (elapsedTime < 0.0) {
-					StopEffect();
-					PlayEffect();
-					elapsedTime = time;
+					Effekseer.Plugin.EffekseerResetTime();
 				}
 			}
 
@@ -71,17 +69,19 @@ namespace Effekseer
 			}
 
 			if (!Application.isPlaying) {
-				double frames = elapsedTime * 60.0f;
-				for (int i = 0; i < frames; i++) {
-					handle.UpdateHandle(1.0f);
-				}
+				// played again natively when it is moved backward
+				handle.Seek((float)(time * 60.0));
 			}
 		}
 
 		private void PlayEffect() {
 			if (effectAsset != null) {
-				handle = EffekseerSystem.PlayEffect(effectAsset, 
-					(emitterObject) ? emitterObject.transform.position : Vector3.zero);
+				var location = (emitterObject) ? emitterObject.transform.position : Vector3.zero;
+				if (Application.isPlaying) {
+					handle = EffekseerSystem.PlayEffect(effectAsset, location);
+				} else {
+					handle = EffekseerSystem.PlaySeekableEffect(effectAsset, location);
+				}
 			}
 		}
 	
@@ -53,27 +53,809 @@ namespace Effekseer
 			return new EffekseerHandle(-1);
 		}
 
+		/// <summary xml:lang="en">
+		/// Plays the effect from the specified frame.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="location" xml:lang="en">Location in world space</param>
+		/// <param name="startFrame" xml:lang="en">Frame to start</param>
+		/// <returns>Played effect instance</returns>
+		/// <summary xml:lang="ja">
+		/// 指定したフレームからエフェクトを再生
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="location" xml:lang="ja">再生開始する位置</param>
+		/// <param name="startFrame" xml:lang="ja">開始フレーム</param>
+		/// <returns>再生したエフェクトインスタンス</returns>
+		public static EffekseerHandle PlayEffect(EffekseerEffectAsset effectAsset, Vector3 location, int startFrame)
+		{
+			if (Instance == null) {
+				Debug.LogError("[Effekseer] System is not initialized.");
+				return new EffekseerHandle(-1);
+			}
+			if (effectAsset == null) {
+				Debug.LogError("[Effekseer] Specified effect is null.");
+				return new EffekseerHandle(-1);
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				int handle = Plugin.EffekseerPlayEffectAtFrame(nativeEffect, location.x, location.y, location.z, startFrame);
+				return new EffekseerHandle(handle);
+			}
+			return new EffekseerHandle(-1);
+		}
+
+		/// <summary xml:lang="en">
+		/// Plays the effect which can be moved to any frame with EffekseerHandle.Seek.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="location" xml:lang="en">Location in world space</param>
+		/// <param name="frame" xml:lang="en">Frame to start</param>
+		/// <returns>Played effect instance</returns>
+		/// <summary xml:lang="ja">
+		/// EffekseerHandle.Seek で任意のフレームに移動できるエフェクトを再生
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="location" xml:lang="ja">再生開始する位置</param>
+		/// <param name="frame" xml:lang="ja">開始フレーム</param>
+		/// <returns>再生したエフェクトインスタンス</returns>
+		public static EffekseerHandle PlaySeekableEffect(EffekseerEffectAsset effectAsset, Vector3 location, float frame = 0.0f)
+		{
+			if (Instance == null) {
+				Debug.LogError("[Effekseer] System is not initialized.");
+				return new EffekseerHandle(-1);
+			}
+			if (effectAsset == null) {
+				Debug.LogError("[Effekseer] Specified effect is null.");
+				return new EffekseerHandle(-1);
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				int handle = Plugin.EffekseerPlaySeekableEffect(nativeEffect, location.x, location.y, location.z, frame);
+				return new EffekseerHandle(handle);
+			}
+			return new EffekseerHandle(-1);
+		}
+
+		/// <summary xml:lang="en">
+		/// Loads the effect if needed and plays it hidden for a frame to avoid a hitch when it is played first.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="count" xml:lang="en">The number of instances which are played at once</param>
+		/// <returns>The number of prewarmed instances</returns>
+		/// <summary xml:lang="ja">
+		/// 初回再生時のヒッチを避けるため、必要ならエフェクトを読み込み、非表示で1フレーム再生する
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="count" xml:lang="ja">同時に再生される数</param>
+		/// <returns>プリウォームされた数</returns>
+		public static int PrewarmEffect(EffekseerEffectAsset effectAsset, int count = 1)
+		{
+			if (Instance == null || effectAsset == null) {
+				return 0;
+			}
+
+			IntPtr nativeEffect;
+			if (!Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				Instance.LoadEffect(effectAsset);
+				Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect);
+			}
+
+			return Plugin.EffekseerPrewarmEffect(nativeEffect, count);
+		}
+
+		/// <summary xml:lang="en">
+		/// Plays the effect at many locations with one native call.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="locations" xml:lang="en">Locations in world space</param>
+		/// <param name="results" xml:lang="en">Played effect instances. It needs the same length as locations.</param>
+		/// <summary xml:lang="ja">
+		/// 複数の位置でエフェクトをまとめて再生する
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="locations" xml:lang="ja">再生開始する位置</param>
+		/// <param name="results" xml:lang="ja">再生したエフェクトインスタンス。locationsと同じ長さが必要</param>
+		public static void PlayEffects(EffekseerEffectAsset effectAsset, Vector3[] locations, EffekseerHandle[] results)
+		{
+			for (int i = 0; i < results.Length; i++) {
+				results[i] = new EffekseerHandle(-1);
+			}
+
+			if (Instance == null) {
+				Debug.LogError("[Effekseer] System is not initialized.");
+				return;
+			}
+			if (effectAsset == null) {
+				Debug.LogError("[Effekseer] Specified effect is null.");
+				return;
+			}
+
+			IntPtr nativeEffect;
+			if (!Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				return;
+			}
+
+			int count = Math.Min(locations.Length, results.Length);
+			float[] positions = new float[count * 3];
+			for (int i = 0; i < count; i++) {
+				positions[i * 3 + 0] = locations[i].x;
+				positions[i * 3 + 1] = locations[i].y;
+				positions[i * 3 + 2] = locations[i].z;
+			}
+
+			int[] handles = new int[count];
+			Plugin.EffekseerPlayEffects(nativeEffect, positions, count, null, null, handles);
+
+			for (int i = 0; i < count; i++) {
+				results[i] = new EffekseerHandle(handles[i]);
+			}
+		}
+
 		/// <summary xml:lang="en">
 		/// Stops all effects
 		/// </summary>
 		/// <summary xml:lang="ja">
-		/// 全エフェクトの再生停止
+		/// 全エフェクトの再生停止
+		/// </summary>
+		public static void StopAllEffects()
+		{
+			Plugin.EffekseerStopAllEffects();
+		}
+
+		/// <summary xml:lang="en">
+		/// Pause or resume all effects
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 全エフェクトの一時停止、もしくは再開
+		/// </summary>
+		public static void SetPausedToAllEffects(bool paused)
+		{
+			Plugin.EffekseerSetPausedToAllEffects(paused);
+		}
+
+		#region Group
+		/// <summary xml:lang="en">
+		/// Stops all effects in the group
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// グループ内の全エフェクトの再生停止
+		/// </summary>
+		public static void StopGroup(int group)
+		{
+			Plugin.EffekseerStopGroup(group);
+		}
+
+		/// <summary xml:lang="en">
+		/// Pause or resume all effects in the group. Effects which join the group later are paused too
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// グループ内の全エフェクトの一時停止、もしくは再開。後からグループに加わったエフェクトにも適用される
+		/// </summary>
+		public static void SetPausedToGroup(int group, bool paused)
+		{
+			Plugin.EffekseerSetPausedToGroup(group, paused);
+		}
+
+		/// <summary xml:lang="en">
+		/// Show or hide all effects in the group. Effects which join the group later are hidden too
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// グループ内の全エフェクトの表示、もしくは非表示。後からグループに加わったエフェクトにも適用される
+		/// </summary>
+		public static void SetShownToGroup(int group, bool shown)
+		{
+			Plugin.EffekseerSetShownToGroup(group, shown);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set playback speed of all effects in the group. It is applied to effects which join the group later too
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// グループ内の全エフェクトの再生速度を設定。後からグループに加わったエフェクトにも適用される
+		/// </summary>
+		public static void SetSpeedToGroup(int group, float speed)
+		{
+			Plugin.EffekseerSetSpeedToGroup(group, speed);
+		}
+		#endregion
+
+		#region Update Scheduler
+		/// <summary xml:lang="en">
+		/// Enable or disable to reduce the update rate of scheduled effects which are far from cameras or out of cameras
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// カメラから遠い、もしくはカメラ外のスケジュール対象エフェクトの更新頻度を下げるかどうかを設定
+		/// </summary>
+		public static void SetUpdateSchedulerEnabled(bool enabled)
+		{
+			Plugin.EffekseerSetUpdateSchedulerEnabled(enabled);
+		}
+
+		/// <summary xml:lang="en">
+		/// Suspend scheduled effects which are out of all cameras for suspensionFrames frames.
+		/// When they come back into view, they are advanced by the elapsed time up to maxCatchUpFrames.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// suspensionFrames フレームの間すべてのカメラ外にあるスケジュール対象エフェクトを停止する。
+		/// 再び表示されたとき、最大 maxCatchUpFrames まで経過時間分進める。
+		/// </summary>
+		public static void SetOffscreenSuspension(bool enabled, int suspensionFrames = 30, float maxCatchUpFrames = 60.0f)
+		{
+			Plugin.EffekseerSetOffscreenSuspension(enabled, suspensionFrames, maxCatchUpFrames);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set update intervals in frames which are used when the distance to the nearest camera is larger than distances[i]
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 最も近いカメラとの距離がdistances[i]以上の場合に使用される更新間隔(フレーム)を設定
+		/// </summary>
+		public static void SetUpdateSchedulerThresholds(float[] distances, int[] intervals, int culledInterval)
+		{
+			int count = Math.Min(distances.Length, intervals.Length);
+			Plugin.EffekseerSetUpdateSchedulerThresholds(distances, intervals, count, culledInterval);
+		}
+
+		/// <summary xml:lang="en">
+		/// Get the number of scheduled, updated, skipped and suspended effects in the last frame
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 直前のフレームでスケジュール対象、更新、スキップ、停止されたエフェクトの数を取得
+		/// </summary>
+		public static void GetUpdateSchedulerStats(out int scheduledCount, out int tickedCount, out int skippedCount, out int suspendedCount)
+		{
+			Plugin.EffekseerGetUpdateSchedulerStats(out scheduledCount, out tickedCount, out skippedCount, out suspendedCount);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set a time budget of updating effects in microseconds. 0 means no budget.
+		/// When the budget is exceeded, effects with low priority are deferred to the next frame.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// エフェクトの更新時間の予算をマイクロ秒で設定する。0は予算なし。
+		/// 予算を超えた場合、優先度の低いエフェクトは次のフレームに延期される。
+		/// </summary>
+		public static void SetUpdateBudget(int microseconds)
+		{
+			Plugin.EffekseerSetUpdateBudget(microseconds);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set an update priority of effects in the group. A priority of each effect is preferred.
+		/// It is used with the update budget and does not enable update scheduling of the effects.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// グループ内のエフェクトの更新優先度を設定する。エフェクトごとの優先度が優先される。
+		/// 更新予算とともに使用され、エフェクトの更新スケジューリングは有効にしない。
+		/// </summary>
+		public static void SetGroupUpdatePriority(int group, int priority)
+		{
+			Plugin.EffekseerSetGroupUpdatePriority(group, priority);
+		}
+
+		/// <summary xml:lang="en">
+		/// Get the update time and the number of deferred effects in the last frame, and the number of frames which exceeded the budget
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 直前のフレームの更新時間と延期されたエフェクトの数、予算を超えたフレームの数を取得
+		/// </summary>
+		public static void GetUpdateBudgetStats(out float updateMicroseconds, out int deferredCount, out int overrunCount)
+		{
+			Plugin.EffekseerGetUpdateBudgetStats(out updateMicroseconds, out deferredCount, out overrunCount);
+		}
+		#endregion
+
+		#region Instance Budget
+		/// <summary xml:lang="en">
+		/// Limit the number of playing effects and instances. 0 means no limit.
+		/// When the budget is exceeded, a new effect is not played or the least important effect is stopped if evictionEnabled is true.
+		/// Importance is the priority of the effect minus the distance to the nearest camera multiplied by distanceWeight.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 再生中のエフェクト数とインスタンス数を制限する。0は制限なし。
+		/// 予算を超えた場合、新しいエフェクトは再生されないか、evictionEnabled が true なら最も重要度の低いエフェクトが停止される。
+		/// 重要度はエフェクトの優先度から最も近いカメラとの距離に distanceWeight を掛けた値を引いたもの。
+		/// </summary>
+		public static void SetInstanceBudget(int maxHandles, int maxInstances, bool evictionEnabled, float distanceWeight = 0.0f)
+		{
+			Plugin.EffekseerSetInstanceBudget(maxHandles, maxInstances, evictionEnabled, distanceWeight);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set a priority of the effect which is used by the instance budget
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// インスタンス予算で使用されるエフェクトの優先度を設定
+		/// </summary>
+		public static void SetEffectPriority(EffekseerEffectAsset effectAsset, int priority)
+		{
+			if (Instance == null || effectAsset == null) {
+				return;
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				Plugin.EffekseerSetEffectPriority(nativeEffect, priority);
+			}
+		}
+
+		/// <summary xml:lang="en">
+		/// Get the budget, the current counts and the number of refused and stopped effects
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 予算、現在の数、再生されなかったエフェクトと停止されたエフェクトの数を取得
+		/// </summary>
+		public static void GetInstanceBudget(out int maxHandles, out int maxInstances, out int handleCount, out int instanceCount, out int refusedCount, out int evictedCount)
+		{
+			Plugin.EffekseerGetInstanceBudget(out maxHandles, out maxInstances, out handleCount, out instanceCount, out refusedCount, out evictedCount);
+		}
+		#endregion
+
+		#region Instanced Effects
+		/// <summary xml:lang="en">
+		/// Create identical effects which share simulations and differ only by transforms.
+		/// The effect is simulated once for each phase bucket. It is available only with the Unity renderer.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="bucketCount" xml:lang="en">The number of simulations which are started at different frames</param>
+		/// <param name="phaseFrames" xml:lang="en">Frames which are divided into buckets. It is usually a loop length of the effect.</param>
+		/// <returns>An id of instanced effects or -1</returns>
+		/// <summary xml:lang="ja">
+		/// シミュレーションを共有し、変換だけが異なる同一のエフェクトを作成する。
+		/// エフェクトは位相バケットごとに1回シミュレーションされる。Unityレンダラーでのみ使用できる。
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="bucketCount" xml:lang="ja">異なるフレームから開始されるシミュレーションの数</param>
+		/// <param name="phaseFrames" xml:lang="ja">バケットに分割されるフレーム数。通常はエフェクトのループの長さ</param>
+		/// <returns>インスタンス化されたエフェクトのIDか-1</returns>
+		public static int CreateInstancedEffect(EffekseerEffectAsset effectAsset, int bucketCount = 1, float phaseFrames = 0.0f)
+		{
+			if (Instance == null || effectAsset == null) {
+				return -1;
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				return Plugin.EffekseerCreateInstancedEffect(nativeEffect, bucketCount, phaseFrames);
+			}
+			return -1;
+		}
+
+		/// <summary xml:lang="en">
+		/// Set transforms of instanced effects. Time offsets in frames are quantized to phase buckets.
+		/// Models are rotated by transforms, but sprites, ribbons, rings and tracks are only translated and scaled so that billboards keep facing the camera.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// インスタンス化されたエフェクトの変換を設定する。フレーム単位の時間オフセットは位相バケットに量子化される。
+		/// モデルは変換により回転するが、スプライト、リボン、リング、軌跡はビルボードがカメラを向き続けるように移動と拡大縮小のみ適用される。
+		/// </summary>
+		public static void SetInstancedTransforms(int id, Matrix4x4[] transforms, float[] timeOffsets = null)
+		{
+			var matrices = new float[transforms.Length * 12];
+			for (int i = 0; i < transforms.Length; i++) {
+				Utility.Matrix2Array43(transforms[i], matrices, i * 12);
+			}
+			Plugin.EffekseerSetInstancedTransforms(id, matrices, timeOffsets, transforms.Length);
+		}
+
+		/// <summary xml:lang="en">
+		/// Get a simulated effect of the phase bucket to change its speed, pause it and so on.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 速度の変更や一時停止などのため、位相バケットのシミュレーションされるエフェクトを取得する。
+		/// </summary>
+		public static EffekseerHandle GetInstancedEffectHandle(int id, int bucket)
+		{
+			return new EffekseerHandle(Plugin.EffekseerGetInstancedEffectHandle(id, bucket));
+		}
+
+		/// <summary xml:lang="en">
+		/// Stop and destroy instanced effects
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// インスタンス化されたエフェクトを停止して破棄する
+		/// </summary>
+		public static void DestroyInstancedEffect(int id)
+		{
+			Plugin.EffekseerDestroyInstancedEffect(id);
+		}
+		#endregion
+
+		#region Baked Clips
+		/// <summary xml:lang="en">
+		/// Capture rendered data of each frame of a loop to play it without simulation.
+		/// It is valid only for deterministic effects which do not face a camera. It is available only with the Unity renderer.
+		/// Call it outside of rendering.
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="en">Effect asset</param>
+		/// <param name="frameCount" xml:lang="en">The number of frames of a loop</param>
+		/// <param name="startFrame" xml:lang="en">Frame where a loop starts</param>
+		/// <returns>An id of a baked clip or -1</returns>
+		/// <summary xml:lang="ja">
+		/// シミュレーションなしで再生するため、ループの各フレームの描画データを記録する。
+		/// カメラの方向を向かない決定的なエフェクトでのみ有効。Unityレンダラーでのみ使用できる。
+		/// 描画中以外に呼び出すこと。
+		/// </summary>
+		/// <param name="effectAsset" xml:lang="ja">エフェクトアセット</param>
+		/// <param name="frameCount" xml:lang="ja">ループのフレーム数</param>
+		/// <param name="startFrame" xml:lang="ja">ループが始まるフレーム</param>
+		/// <returns>ベイクされたクリップのIDか-1</returns>
+		public static int BakeEffect(EffekseerEffectAsset effectAsset, int frameCount, int startFrame = 0)
+		{
+			if (Instance == null || effectAsset == null) {
+				return -1;
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				return Plugin.EffekseerBakeEffect(nativeEffect, startFrame, frameCount);
+			}
+			return -1;
+		}
+
+		/// <summary xml:lang="en">
+		/// Load a baked clip which was saved with SaveBakedClip. The effect must be the same as the baked effect.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// SaveBakedClip で保存されたベイク済みクリップを読み込む。エフェクトはベイクしたエフェクトと同じである必要がある。
+		/// </summary>
+		public static int LoadBakedClip(EffekseerEffectAsset effectAsset, byte[] data)
+		{
+			if (Instance == null || effectAsset == null || data == null) {
+				return -1;
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				return Plugin.EffekseerLoadBakedClip(nativeEffect, data, data.Length);
+			}
+			return -1;
+		}
+
+		/// <summary xml:lang="en">
+		/// Serialize a baked clip
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// ベイク済みクリップをシリアライズする
+		/// </summary>
+		public static byte[] SaveBakedClip(int id)
+		{
+			int size = Plugin.EffekseerSaveBakedClip(id, null, 0);
+			if (size <= 0) {
+				return null;
+			}
+
+			var data = new byte[size];
+			Plugin.EffekseerSaveBakedClip(id, data, size);
+			return data;
+		}
+
+		/// <summary xml:lang="en">
+		/// Save a baked clip to a file
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// ベイク済みクリップをファイルに保存する
+		/// </summary>
+		public static bool SaveBakedClip(int id, string path)
+		{
+			var data = SaveBakedClip(id);
+			if (data == null) {
+				return false;
+			}
+
+			File.WriteAllBytes(path, data);
+			return true;
+		}
+
+		/// <summary xml:lang="en">
+		/// Set transforms of instances of a baked clip. Time offsets are in frames.
+		/// Models are rotated by transforms, but sprites, ribbons, rings and tracks are only translated and scaled.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// ベイク済みクリップのインスタンスの変換を設定する。時間オフセットはフレーム単位。
+		/// モデルは変換により回転するが、スプライト、リボン、リング、軌跡は移動と拡大縮小のみ適用される。
+		/// </summary>
+		public static void SetBakedClipTransforms(int id, Matrix4x4[] transforms, float[] timeOffsets = null)
+		{
+			var matrices = new float[transforms.Length * 12];
+			for (int i = 0; i < transforms.Length; i++) {
+				Utility.Matrix2Array43(transforms[i], matrices, i * 12);
+			}
+			Plugin.EffekseerSetBakedClipTransforms(id, matrices, timeOffsets, transforms.Length);
+		}
+
+		/// <summary xml:lang="en">
+		/// Destroy a baked clip
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// ベイク済みクリップを破棄する
+		/// </summary>
+		public static void DestroyBakedClip(int id)
+		{
+			Plugin.EffekseerDestroyBakedClip(id);
+		}
+		#endregion
+
+		#region Independent Managers
+		/// <summary xml:lang="en">
+		/// Create a manager which has its own instance pool, for example for an additive scene or a preview.
+		/// It is updated only by UpdateManager and can be updated on another thread. Sounds are not played.
+		/// </summary>
+		/// <returns>An id of a manager or -1</returns>
+		/// <summary xml:lang="ja">
+		/// 加算シーンやプレビューなどのため、独自のインスタンスプールを持つマネージャーを作成する。
+		/// UpdateManager でのみ更新され、別のスレッドで更新できる。サウンドは再生されない。
+		/// </summary>
+		/// <returns>マネージャーのIDか-1</returns>
+		public static int CreateManager(int maxInstances)
+		{
+			return Plugin.EffekseerCreateManager(maxInstances);
+		}
+
+		/// <summary xml:lang="en">
+		/// Destroy a manager and all of its effects
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャーとその全てのエフェクトを破棄する
+		/// </summary>
+		public static void DestroyManager(int managerId)
+		{
+			Plugin.EffekseerDestroyManager(managerId);
+		}
+
+		/// <summary xml:lang="en">
+		/// Update a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャーを更新する
 		/// </summary>
-		public static void StopAllEffects()
+		public static void UpdateManager(int managerId, float deltaFrame)
 		{
-			Plugin.EffekseerStopAllEffects();
+			Plugin.EffekseerManagerUpdate(managerId, deltaFrame);
 		}
 
 		/// <summary xml:lang="en">
-		/// Pause or resume all effects
+		/// Specify whether a manager is rendered with the default manager
 		/// </summary>
 		/// <summary xml:lang="ja">
-		/// 全エフェクトの一時停止、もしくは再開
+		/// マネージャーをデフォルトのマネージャーと一緒に描画するか指定する
 		/// </summary>
-		public static void SetPausedToAllEffects(bool paused)
+		public static void SetManagerRendered(int managerId, bool rendered)
 		{
-			Plugin.EffekseerSetPausedToAllEffects(paused);
+			Plugin.EffekseerManagerSetRendered(managerId, rendered);
+		}
+
+		/// <summary xml:lang="en">
+		/// Play the effect in a manager
+		/// </summary>
+		/// <returns>A handle in the manager or -1</returns>
+		/// <summary xml:lang="ja">
+		/// マネージャーでエフェクトを再生する
+		/// </summary>
+		/// <returns>マネージャー内のハンドルか-1</returns>
+		public static int PlayEffectInManager(int managerId, EffekseerEffectAsset effectAsset, Vector3 location)
+		{
+			if (Instance == null || effectAsset == null) {
+				return -1;
+			}
+
+			IntPtr nativeEffect;
+			if (Instance.nativeEffects.TryGetValue(effectAsset.GetInstanceID(), out nativeEffect)) {
+				return Plugin.EffekseerManagerPlayEffect(managerId, nativeEffect, location.x, location.y, location.z);
+			}
+			return -1;
+		}
+
+		/// <summary xml:lang="en">
+		/// Stop an effect in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のエフェクトを停止する
+		/// </summary>
+		public static void StopEffectInManager(int managerId, int handle)
+		{
+			Plugin.EffekseerManagerStopEffect(managerId, handle);
+		}
+
+		/// <summary xml:lang="en">
+		/// Stop all effects in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内の全てのエフェクトを停止する
+		/// </summary>
+		public static void StopAllEffectsInManager(int managerId)
+		{
+			Plugin.EffekseerManagerStopAllEffects(managerId);
+		}
+
+		/// <summary xml:lang="en">
+		/// Whether an effect exists in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内にエフェクトが存在するか
+		/// </summary>
+		public static bool ExistsInManager(int managerId, int handle)
+		{
+			return Plugin.EffekseerManagerExists(managerId, handle);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set a transform of an effect in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のエフェクトの変換を設定する
+		/// </summary>
+		public static void SetTransformInManager(int managerId, int handle, Vector3 location, Quaternion rotation, Vector3 scale)
+		{
+			Vector3 axis;
+			float angle;
+			rotation.ToAngleAxis(out angle, out axis);
+			Plugin.EffekseerManagerSetLocation(managerId, handle, location.x, location.y, location.z);
+			Plugin.EffekseerManagerSetRotation(managerId, handle, axis.x, axis.y, axis.z, angle * Mathf.Deg2Rad);
+			Plugin.EffekseerManagerSetScale(managerId, handle, scale.x, scale.y, scale.z);
+		}
+
+		/// <summary xml:lang="en">
+		/// Show or hide an effect in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のエフェクトを表示または非表示にする
+		/// </summary>
+		public static void SetShownInManager(int managerId, int handle, bool shown)
+		{
+			Plugin.EffekseerManagerSetShown(managerId, handle, shown);
+		}
+
+		/// <summary xml:lang="en">
+		/// Pause or resume an effect in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のエフェクトを一時停止または再開する
+		/// </summary>
+		public static void SetPausedInManager(int managerId, int handle, bool paused)
+		{
+			Plugin.EffekseerManagerSetPaused(managerId, handle, paused);
+		}
+
+		/// <summary xml:lang="en">
+		/// Set a speed of an effect in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のエフェクトの速度を設定する
+		/// </summary>
+		public static void SetSpeedInManager(int managerId, int handle, float speed)
+		{
+			Plugin.EffekseerManagerSetSpeed(managerId, handle, speed);
+		}
+
+		/// <summary xml:lang="en">
+		/// Get the number of instances in a manager
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// マネージャー内のインスタンス数を取得する
+		/// </summary>
+		public static int GetInstanceCountInManager(int managerId)
+		{
+			return Plugin.EffekseerManagerGetInstanceCount(managerId);
+		}
+		#endregion
+
+		#region Async Loading
+		/// <summary xml:lang="en">
+		/// Whether effect assets which are enabled are loaded on a worker thread.
+		/// An effect cannot be played until it is loaded.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 有効になったエフェクトアセットをワーカースレッドで読み込むかどうか。
+		/// 読み込まれるまでエフェクトは再生できない。
+		/// </summary>
+		public static bool LoadsEffectsAsynchronously = false;
+
+		/// <summary xml:lang="en">
+		/// Time in milliseconds which the main thread spends for resources of loading effects in a frame
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 読み込み中のエフェクトのリソースのために1フレームでメインスレッドが使う時間(ミリ秒)
+		/// </summary>
+		public static float AsyncLoadingBudget = 2.0f;
+
+		/// <summary xml:lang="en">
+		/// Start to load the effect on a worker thread. Resources are loaded on the main thread while the system is updated.
+		/// </summary>
+		/// <returns>Whether the effect is loaded or in loading</returns>
+		/// <summary xml:lang="ja">
+		/// ワーカースレッドでエフェクトの読み込みを開始する。リソースはシステムの更新中にメインスレッドで読み込まれる。
+		/// </summary>
+		/// <returns>エフェクトが読み込まれたか読み込み中か</returns>
+		public static bool LoadEffectAsync(EffekseerEffectAsset effectAsset)
+		{
+			if (Instance == null || effectAsset == null) {
+				return false;
+			}
+
+			return Instance.StartLoadingEffect(effectAsset);
+		}
+
+		/// <summary xml:lang="en">
+		/// Whether the effect is in loading
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// エフェクトが読み込み中かどうか
+		/// </summary>
+		public static bool IsEffectLoading(EffekseerEffectAsset effectAsset)
+		{
+			if (Instance == null || effectAsset == null) {
+				return false;
+			}
+
+			return Instance.loadingTickets.ContainsKey(effectAsset.GetInstanceID());
+		}
+		#endregion
+
+		#region Material Loading
+		/// <summary xml:lang="en">
+		/// Time in milliseconds which the render thread spends for compiling materials in a frame. 0 means no limit.
+		/// Materials which are not compiled are not drawn until they are compiled.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 1フレームでレンダリングスレッドがマテリアルのコンパイルに使う時間(ミリ秒)。0は無制限。
+		/// コンパイルされていないマテリアルはコンパイルされるまで描画されない。
+		/// </summary>
+		public static float MaterialLoadingBudget = 0.0f;
+
+		/// <summary xml:lang="en">
+		/// The number of materials which are compiled in a frame. 0 means no limit.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// 1フレームでコンパイルされるマテリアルの数。0は無制限。
+		/// </summary>
+		public static int MaterialLoadingCountBudget = 0;
+
+		/// <summary xml:lang="en">
+		/// The number of materials which wait for compiling. Materials of played effects are compiled first.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// コンパイル待ちのマテリアルの数。再生されたエフェクトのマテリアルが先にコンパイルされる。
+		/// </summary>
+		public static int PendingMaterialCount
+		{
+			get { return Plugin.EffekseerGetPendingMaterialCount(); }
+		}
+		#endregion
+
+		#region Bundles
+		/// <summary xml:lang="en">
+		/// Open a bundle (.efkpkg) made by EffekseerBundleBuilder.
+		/// Models and materials of effects are loaded from opened bundles without calling Unity.
+		/// </summary>
+		/// <returns>An id of the bundle or -1 if it is failed to open</returns>
+		/// <summary xml:lang="ja">
+		/// EffekseerBundleBuilderで作成したバンドル(.efkpkg)を開く。
+		/// エフェクトのモデルとマテリアルはUnityを呼ばずに開いているバンドルから読み込まれる。
+		/// </summary>
+		/// <returns>バンドルのID、開けなかった場合は-1</returns>
+		public static int OpenBundle(string path)
+		{
+			var pathPtr = Marshal.StringToCoTaskMemUni(path);
+			int id = Plugin.EffekseerOpenBundle(pathPtr);
+			Marshal.FreeCoTaskMem(pathPtr);
+			return id;
+		}
+
+		/// <summary xml:lang="en">
+		/// Close a bundle. Loaded resources are kept.
+		/// </summary>
+		/// <summary xml:lang="ja">
+		/// バンドルを閉じる。読み込まれたリソースは保持される。
+		/// </summary>
+		public static void CloseBundle(int id)
+		{
+			Plugin.EffekseerCloseBundle(id);
 		}
+		#endregion
 
 		#region Network
 		/// <summary xml:lang="en">
@@ -126,6 +908,11 @@ namespace Effekseer
 		// A AssetBundle that current loading
 		private EffekseerEffectAsset effectAssetInLoading;
 
+		// Effects which are loaded asynchronously
+		private Dictionary<int, EffekseerEffectAsset> loadingEffects = new Dictionary<int, EffekseerEffectAsset>();
+		private Dictionary<int, int> loadingTickets = new Dictionary<int, int>();
+		private List<int> loadedTickets = new List<int>();
+
 		internal Effekseer.EffekseerRendererType RendererType { get; private set; }
 
 		private static Dictionary<IntPtr, Texture> cachedTextures = new Dictionary<IntPtr, Texture>();
@@ -142,6 +929,9 @@ namespace Effekseer
 
 		private static Dictionary<EffekseerMaterialAsset, IntPtr> cachedMaterialIDs = new Dictionary<EffekseerMaterialAsset, IntPtr>();
 
+		// buffers which are pinned while the plugin reads them
+		private static Dictionary<string, List<GCHandle>> borrowedBuffers = new Dictionary<string, List<GCHandle>>();
+
 		static Vector3 lightDirection = new Vector3(1, 1, -1);
 
 		static Color lightColor = new Color(255.0f / 255.0f, 255.0f / 255.0f, 255.0f / 255.0f);
@@ -212,6 +1002,11 @@ namespace Effekseer
 		/// Don't touch it!!
 		/// </summary>
 		public void LoadEffect(EffekseerEffectAsset effectAsset) {
+			if (LoadsEffectsAsynchronously && !nativeEffects.ContainsKey(effectAsset.GetInstanceID())) {
+				StartLoadingEffect(effectAsset);
+				return;
+			}
+
 			effectAssetInLoading = effectAsset;
 			int id = effectAsset.GetInstanceID();
 			IntPtr nativeEffect;
@@ -233,8 +1028,77 @@ namespace Effekseer
 			effectAssetInLoading = null;
 		}
 
+		private bool StartLoadingEffect(EffekseerEffectAsset effectAsset) {
+			int id = effectAsset.GetInstanceID();
+			if (nativeEffects.ContainsKey(id) || loadingTickets.ContainsKey(id)) {
+				return true;
+			}
+
+			byte[] bytes = effectAsset.efkBytes;
+			var namePtr = Marshal.StringToCoTaskMemUni(effectAsset.name);
+			int ticket = Plugin.EffekseerLoadEffectAsync(bytes, bytes.Length, namePtr, effectAsset.Scale);
+			Marshal.FreeCoTaskMem(namePtr);
+
+			if (ticket < 0) {
+				return false;
+			}
+
+			loadingEffects.Add(ticket, effectAsset);
+			loadingTickets.Add(id, ticket);
+			return true;
+		}
+
+		private EffekseerEffectAsset GetEffectAssetInLoading() {
+			if (effectAssetInLoading != null) {
+				return effectAssetInLoading;
+			}
+
+			// Resources of an effect which is loaded asynchronously
+			EffekseerEffectAsset effectAsset;
+			loadingEffects.TryGetValue(Plugin.EffekseerGetPumpingLoadTicket(), out effectAsset);
+			return effectAsset;
+		}
+
+		private void PumpEffectLoads() {
+			if (loadingEffects.Count == 0) {
+				return;
+			}
+
+			Plugin.EffekseerPumpEffectLoads(AsyncLoadingBudget);
+
+			loadedTickets.Clear();
+			foreach (var ticket in loadingEffects.Keys) {
+				if (Plugin.EffekseerGetLoadEffectState(ticket) != 0) {
+					loadedTickets.Add(ticket);
+				}
+			}
+
+			foreach (var ticket in loadedTickets) {
+				var effectAsset = loadingEffects[ticket];
+				int id = effectAsset.GetInstanceID();
+				loadingEffects.Remove(ticket);
+
+				IntPtr nativeEffect = Plugin.EffekseerTakeLoadedEffect(ticket);
+
+				// The effect was released or loaded synchronously while it was in loading
+				int currentTicket;
+				if (!loadingTickets.TryGetValue(id, out currentTicket) || currentTicket != ticket || nativeEffects.ContainsKey(id)) {
+					Plugin.EffekseerReleaseEffect(nativeEffect);
+					continue;
+				}
+				loadingTickets.Remove(id);
+
+				if (nativeEffect == IntPtr.Zero) {
+					Debug.LogWarning("[Effekseer] Failed to load " + effectAsset.name);
+					continue;
+				}
+				nativeEffects.Add(id, nativeEffect);
+			}
+		}
+
 		internal void ReleaseEffect(EffekseerEffectAsset effectAsset) {
 			int id = effectAsset.GetInstanceID();
+			loadingTickets.Remove(id);
 			IntPtr nativeEffect;
 			if (nativeEffects.TryGetValue(id, out nativeEffect)) {
 				Plugin.EffekseerReleaseEffect(nativeEffect);
@@ -387,6 +1251,10 @@ namespace Effekseer
 				}
 			}
 			nativeEffects.Clear();
+
+			// Effects in loading are released by the plugin
+			loadingEffects.Clear();
+			loadingTickets.Clear();
 			
 #if UNITY_EDITOR
 			nativeEffectsKeys.Clear();
@@ -434,6 +1302,14 @@ namespace Effekseer
 				MaterialLoaderLoad,
 				MaterialLoaderUnload);
 
+			// The plugin reads models and materials from managed buffers without copying them
+			Plugin.EffekseerSetModelLoaderBorrowEvent(
+				ModelLoaderBorrow,
+				LoaderGiveBack);
+			Plugin.EffekseerSetMaterialLoaderBorrowEvent(
+				MaterialLoaderBorrow,
+				LoaderGiveBack);
+
 #if UNITY_EDITOR
 			for (int i = 0; i < nativeEffectsKeys.Count; i++) {
 				IntPtr nativeEffect = new IntPtr((long)ulong.Parse(nativeEffectsValues[i]));
@@ -471,6 +1347,8 @@ namespace Effekseer
 			Plugin.EffekseerSetModelLoaderEvent(null, null);
 			Plugin.EffekseerSetSoundLoaderEvent(null, null);
 			Plugin.EffekseerSetMaterialLoaderEvent(null, null);
+			Plugin.EffekseerSetModelLoaderBorrowEvent(null, null);
+			Plugin.EffekseerSetMaterialLoaderBorrowEvent(null, null);
 		}
 
 #if UNITY_EDITOR
@@ -483,6 +1361,9 @@ namespace Effekseer
 		float restFrames = 0;
 
 		internal void Update(float deltaTime) {
+			PumpEffectLoads();
+			Plugin.EffekseerSetMaterialLoadBudget(MaterialLoadingBudget, MaterialLoadingCountBudget);
+
 			float deltaFrames = Utility.TimeToFrames(deltaTime);
 			restFrames += deltaFrames;
 			int updateCount = Mathf.RoundToInt(restFrames);
@@ -552,7 +1433,7 @@ namespace Effekseer
 		private static IntPtr TextureLoaderLoad(IntPtr path, out int width, out int height, out int format)
 		{
 			var pathstr = Marshal.PtrToStringUni(path);
-			var asset = Instance.effectAssetInLoading;
+			var asset = Instance.GetEffectAssetInLoading();
 			var res = asset.FindTexture(pathstr);
 			var texture = (res != null) ? res.texture : null;
 
@@ -626,7 +1507,7 @@ namespace Effekseer
 		private static IntPtr ModelLoaderLoad(IntPtr path, IntPtr buffer, int bufferSize, ref int requiredBufferSize) {
 			var pathstr = Marshal.PtrToStringUni(path);
 			pathstr = Path.ChangeExtension(pathstr, ".asset");
-			var asset = Instance.effectAssetInLoading;
+			var asset = Instance.GetEffectAssetInLoading();
 			var res = asset.FindModel(pathstr);
 			var model = (res != null) ? res.asset : null;
 
@@ -635,24 +1516,96 @@ namespace Effekseer
 
 				if (model.bytes.Length <= bufferSize) {
 					Marshal.Copy(model.bytes, 0, buffer, model.bytes.Length);
+					return CreateModel(model);
+				}
+			}
 
-					if(Instance.RendererType == EffekseerRendererType.Unity)
-					{
-						var unityRendererModel = new UnityRendererModel();
-						unityRendererModel.Initialize(model.bytes);
+			return IntPtr.Zero;
+		}
 
-						IntPtr ptr = unityRendererModel.VertexBuffer.GetNativeBufferPtr();
-						if (!cachedModels.ContainsKey(ptr)) {
-							cachedModels.Add(ptr, unityRendererModel);
-						}
-						return ptr;
-					}
+		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerModelLoaderBorrow))]
+		private static IntPtr ModelLoaderBorrow(IntPtr path, ref IntPtr data, ref int dataSize) {
+			var pathstr = Marshal.PtrToStringUni(path);
+			var asset = Instance.GetEffectAssetInLoading();
+			var res = asset.FindModel(Path.ChangeExtension(pathstr, ".asset"));
+			var model = (res != null) ? res.asset : null;
+
+			if (model == null || model.bytes == null) {
+				return IntPtr.Zero;
+			}
+
+			// data is not given back if a model is not created
+			var modelPtr = CreateModel(model);
+			if (modelPtr == IntPtr.Zero) {
+				return IntPtr.Zero;
+			}
+
+			data = PinBuffer(pathstr, model.bytes);
+			dataSize = model.bytes.Length;
+			return modelPtr;
+		}
+
+		// return null if a compressed container is broken
+		private static byte[] DecompressModel(byte[] bytes) {
+			int size = Plugin.EffekseerGetDecompressedSize(bytes, bytes.Length);
+			if (size < 0) {
+				return bytes;
+			}
+
+			var decompressed = new byte[size];
+			if (size == 0 || Plugin.EffekseerDecompress(bytes, bytes.Length, decompressed, size) == 0) {
+				return null;
+			}
+			return decompressed;
+		}
+
+		private static IntPtr CreateModel(EffekseerModelAsset model) {
+			if(Instance.RendererType == EffekseerRendererType.Unity)
+			{
+				// a model is parsed here with the Unity renderer
+				var bytes = DecompressModel(model.bytes);
+				if (bytes == null) {
+					Debug.LogError("[Effekseer] Failed to decompress a model : " + model.name);
+					return IntPtr.Zero;
+				}
+
+				var unityRendererModel = new UnityRendererModel();
+				unityRendererModel.Initialize(bytes);
 
-					return new IntPtr(1);
+				IntPtr ptr = unityRendererModel.VertexBuffer.GetNativeBufferPtr();
+				if (!cachedModels.ContainsKey(ptr)) {
+					cachedModels.Add(ptr, unityRendererModel);
 				}
+				return ptr;
 			}
 
-			return IntPtr.Zero;
+			return new IntPtr(1);
+		}
+
+		private static IntPtr PinBuffer(string path, byte[] buffer) {
+			var handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+
+			List<GCHandle> handles;
+			if (!borrowedBuffers.TryGetValue(path, out handles)) {
+				handles = new List<GCHandle>();
+				borrowedBuffers.Add(path, handles);
+			}
+			handles.Add(handle);
+
+			return handle.AddrOfPinnedObject();
+		}
+
+		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerLoaderGiveBack))]
+		private static void LoaderGiveBack(IntPtr path) {
+			var pathstr = Marshal.PtrToStringUni(path);
+
+			List<GCHandle> handles;
+			if (borrowedBuffers.TryGetValue(pathstr, out handles)) {
+				foreach (var handle in handles) {
+					handle.Free();
+				}
+				borrowedBuffers.Remove(pathstr);
+			}
 		}
 
 		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerModelLoaderUnload))]
@@ -675,7 +1628,7 @@ namespace Effekseer
 		{
 			var pathstr = Marshal.PtrToStringUni(path);
 			pathstr = Path.ChangeExtension(pathstr, ".asset");
-			var asset = Instance.effectAssetInLoading;
+			var asset = Instance.GetEffectAssetInLoading();
 			var res = asset.FindMaterial(pathstr);
 			var material = (res != null) ? res.asset : null;
 
@@ -704,23 +1657,7 @@ namespace Effekseer
 							Marshal.Copy(material.materialBuffers, 0, materialBuffer, material.materialBuffers.Length);
 						}
 
-						var ptr = new IntPtr();
-						do
-						{
-							materialIDCounter++;
-							if (materialIDCounter > int.MaxValue / 2)
-							{
-								materialIDCounter = 0;
-							}
-							ptr = new IntPtr(materialIDCounter);
-						}
-						while (cachedMaterials.ContainsKey(ptr));
-
-						var unityRendererMaterial = new UnityRendererMaterial(material);
-
-						cachedMaterials.Add(ptr, unityRendererMaterial);
-						cachedMaterialIDs.Add(material, ptr);
-						return ptr;
+						return CreateUnityRendererMaterial(material);
 					}
 				}
 				else
@@ -758,6 +1695,78 @@ namespace Effekseer
 			return IntPtr.Zero;
 		}
 
+		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerMaterialLoaderBorrow))]
+		private static IntPtr MaterialLoaderBorrow(IntPtr path,
+			ref IntPtr materialData, ref int materialDataSize,
+			ref IntPtr cachedMaterialData, ref int cachedMaterialDataSize)
+		{
+			var pathstr = Marshal.PtrToStringUni(path);
+			var asset = Instance.GetEffectAssetInLoading();
+			var res = asset.FindMaterial(Path.ChangeExtension(pathstr, ".asset"));
+			var material = (res != null) ? res.asset : null;
+
+			if (material == null)
+			{
+				return IntPtr.Zero;
+			}
+
+			if (Instance.RendererType == EffekseerRendererType.Unity)
+			{
+				if (material.materialBuffers == null)
+				{
+					return IntPtr.Zero;
+				}
+
+				materialData = PinBuffer(pathstr, material.materialBuffers);
+				materialDataSize = material.materialBuffers.Length;
+				return CreateUnityRendererMaterial(material);
+			}
+
+			int status = 0;
+
+			if (material.cachedMaterialBuffers != null)
+			{
+				cachedMaterialData = PinBuffer(pathstr, material.cachedMaterialBuffers);
+				cachedMaterialDataSize = material.cachedMaterialBuffers.Length;
+				status += 2;
+			}
+
+			if (material.materialBuffers != null)
+			{
+				materialData = PinBuffer(pathstr, material.materialBuffers);
+				materialDataSize = material.materialBuffers.Length;
+				status += 1;
+			}
+
+			return new IntPtr(status);
+		}
+
+		private static IntPtr CreateUnityRendererMaterial(EffekseerMaterialAsset material)
+		{
+			IntPtr ptr;
+			if (cachedMaterialIDs.TryGetValue(material, out ptr))
+			{
+				return ptr;
+			}
+
+			do
+			{
+				materialIDCounter++;
+				if (materialIDCounter > int.MaxValue / 2)
+				{
+					materialIDCounter = 0;
+				}
+				ptr = new IntPtr(materialIDCounter);
+			}
+			while (cachedMaterials.ContainsKey(ptr));
+
+			var unityRendererMaterial = new UnityRendererMaterial(material);
+
+			cachedMaterials.Add(ptr, unityRendererMaterial);
+			cachedMaterialIDs.Add(material, ptr);
+			return ptr;
+		}
+
 		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerMaterialLoaderUnload))]
 		private static void MaterialLoaderUnload(IntPtr path, IntPtr materialPtr)
 		{
@@ -775,7 +1784,7 @@ namespace Effekseer
 		[AOT.MonoPInvokeCallback(typeof(Plugin.EffekseerSoundLoaderLoad))]
 		private static IntPtr SoundLoaderLoad(IntPtr path) {
 			var pathstr = Marshal.PtrToStringUni(path);
-			var asset = Instance.effectAssetInLoading;
+			var asset = Instance.GetEffectAssetInLoading();
 			
 			var res = asset.FindSound(pathstr);
 			if (res != null) {